@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include "engine/order_book.hpp"
+#include "engine/tick_ladder_book.hpp"
+
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Map vs tick-ladder layout on a liquid-symbol shape: prices clustered within a few
+// thousand ticks of mid. Run: ./bench_order_book --benchmark_counters_tabular=true
+
+namespace mat_eng = matching_engine::v1;
+
+static constexpr PriceQ4 kMid = 1'000'000;   // 100.0000 in Q4
+
+// Pre-built flow so the timed loop only measures the book
+static std::vector<Order> make_flow(std::size_t n, double spread_ticks) {
+  std::mt19937_64 rng(7);
+  std::normal_distribution<double> dist(0.0, spread_ticks);
+  std::vector<Order> flow;
+  flow.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool buy = (i % 2) == 0;
+    const auto off = static_cast<PriceQ4>(std::abs(dist(rng))) + 1;
+    flow.push_back(Order::FromRaw("OID-" + std::to_string(i), "C1", "SYM",
+                                  buy ? kMid - off : kMid + off, kTargetScale, 10,
+                                  buy ? mat_eng::BUY : mat_eng::SELL));
+  }
+  return flow;
+}
+
+// Insert a burst of orders into a fresh book
+template <class Book>
+static void BM_Add(benchmark::State& state) {
+  const auto flow = make_flow(static_cast<std::size_t>(state.range(0)), 500.0);
+  for (auto _ : state) {
+    Book book;
+    for (const auto& o : flow) book.add(o);
+    benchmark::DoNotOptimize(book.order_count());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Top of book on a populated book
+template <class Book>
+static void BM_BestPrices(benchmark::State& state) {
+  Book book;
+  for (const auto& o : make_flow(static_cast<std::size_t>(state.range(0)), 500.0)) book.add(o);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(book.best_bid());
+    benchmark::DoNotOptimize(book.best_ask());
+  }
+}
+
+// Walk every non-empty level of both sides, best first (full depth snapshot)
+template <class Book>
+static void BM_WalkLevels(benchmark::State& state) {
+  Book book;
+  for (const auto& o : make_flow(static_cast<std::size_t>(state.range(0)), 500.0)) book.add(o);
+  for (auto _ : state) {
+    int64_t qty = 0;
+    for (Side side : {mat_eng::BUY, mat_eng::SELL})
+      book.for_each_level(side, [&](PriceQ4, const PriceLevel& lvl) { qty += lvl.total_qty; });
+    benchmark::DoNotOptimize(qty);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Add, MapOrderBook)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Add, TickLadderBook)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_BestPrices, MapOrderBook)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_BestPrices, TickLadderBook)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_WalkLevels, MapOrderBook)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_WalkLevels, TickLadderBook)->Arg(100000);
+
+BENCHMARK_MAIN();
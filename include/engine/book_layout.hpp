@@ -0,0 +1,48 @@
+#pragma once
+
+#include "engine/order_book.hpp"
+#include "engine/tick_ladder_book.hpp"
+#include "runtime/runtime_config.hpp"
+
+#include <memory_resource>
+#include <optional>
+#include <variant>
+
+// Per-symbol book whose layout (ordered map or dense tick ladder) is picked at creation.
+// std::variant rather than a virtual base: the layout is fixed for the book's lifetime and
+// std::visit keeps the calls inlinable.
+class OrderBook {
+public:
+  OrderBook(BookLayout layout, std::pmr::memory_resource* mr, std::size_t ladder_ticks)
+    : impl_(make(layout, mr, ladder_ticks)) {}
+
+  void add(const Order& o) { std::visit([&](auto& b) { b.add(o); }, impl_); }
+
+  std::optional<int64_t> remove(Side side, PriceQ4 px, const std::string& order_id) {
+    return std::visit([&](auto& b) { return b.remove(side, px, order_id); }, impl_);
+  }
+
+  std::optional<PriceQ4> best_bid() const { return std::visit([](const auto& b) { return b.best_bid(); }, impl_); }
+  std::optional<PriceQ4> best_ask() const { return std::visit([](const auto& b) { return b.best_ask(); }, impl_); }
+
+  template <class F>
+  void for_each_level(Side side, F&& f) const {
+    std::visit([&](const auto& b) { b.for_each_level(side, f); }, impl_);
+  }
+
+  std::size_t order_count() const { return std::visit([](const auto& b) { return b.order_count(); }, impl_); }
+
+  BookLayout layout() const {
+    return std::holds_alternative<TickLadderBook>(impl_) ? BookLayout::TickLadder : BookLayout::Map;
+  }
+
+private:
+  using Impl = std::variant<MapOrderBook, TickLadderBook>;
+
+  static Impl make(BookLayout layout, std::pmr::memory_resource* mr, std::size_t ladder_ticks) {
+    if (layout == BookLayout::TickLadder) return Impl(std::in_place_type<TickLadderBook>, mr, ladder_ticks);
+    return Impl(std::in_place_type<MapOrderBook>, mr);
+  }
+
+  Impl impl_;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+// Two-level occupancy bitmap over [0, size): bit i set <=> slot i is non-empty.
+// Notes:
+//  - leaf word w covers slots [64w, 64w+63]; summary bit w is set iff leaf word w != 0.
+//    One summary word therefore covers 4096 slots, so a typical ladder needs 1-2 summary words.
+//  - first/last/next/prev are a couple of ctz/clz per level: no loop over empty slots.
+class OccupancyBitmap {
+public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  explicit OccupancyBitmap(std::size_t size, std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+    : size_(size), leaf_((size + 63) / 64, 0, mr), summary_((leaf_.size() + 63) / 64, 0, mr) {}
+
+  std::size_t size() const { return size_; }
+
+  void set(std::size_t i) {
+    leaf_[i >> 6] |= bit(i & 63);
+    summary_[i >> 12] |= bit((i >> 6) & 63);
+  }
+
+  void clear(std::size_t i) {
+    uint64_t& w = leaf_[i >> 6];
+    w &= ~bit(i & 63);
+    if (w == 0) summary_[i >> 12] &= ~bit((i >> 6) & 63);
+  }
+
+  bool test(std::size_t i) const { return (leaf_[i >> 6] & bit(i & 63)) != 0; }
+
+  bool empty() const {
+    for (uint64_t s : summary_) if (s) return false;
+    return true;
+  }
+
+  void reset() {
+    std::fill(leaf_.begin(), leaf_.end(), 0);
+    std::fill(summary_.begin(), summary_.end(), 0);
+  }
+
+  std::size_t first() const { return next(0); }
+  std::size_t last()  const { return size_ == 0 ? npos : prev(size_ - 1); }
+
+  // Lowest set slot >= from, or npos.
+  std::size_t next(std::size_t from) const {
+    if (from >= size_) return npos;
+    const std::size_t w = from >> 6;
+    if (uint64_t bits = leaf_[w] & (~uint64_t(0) << (from & 63)))
+      return (w << 6) + std::countr_zero(bits);
+
+    const std::size_t wn = w + 1;                    // first leaf word still to look at
+    if (wn >= leaf_.size()) return npos;
+    std::size_t s = wn >> 6;
+    uint64_t sb = summary_[s] & (~uint64_t(0) << (wn & 63));
+    for (;;) {
+      if (sb) {
+        const std::size_t lw = (s << 6) + std::countr_zero(sb);
+        return (lw << 6) + std::countr_zero(leaf_[lw]);
+      }
+      if (++s >= summary_.size()) return npos;
+      sb = summary_[s];
+    }
+  }
+
+  // Highest set slot <= from, or npos.
+  std::size_t prev(std::size_t from) const {
+    if (from == npos || size_ == 0) return npos;
+    if (from >= size_) from = size_ - 1;
+    const std::size_t w = from >> 6;
+    if (uint64_t bits = leaf_[w] & (~uint64_t(0) >> (63 - (from & 63))))
+      return (w << 6) + 63 - std::countl_zero(bits);
+
+    if (w == 0) return npos;
+    const std::size_t wp = w - 1;                    // last leaf word still to look at
+    std::size_t s = wp >> 6;
+    uint64_t sb = summary_[s] & (~uint64_t(0) >> (63 - (wp & 63)));
+    for (;;) {
+      if (sb) {
+        const std::size_t lw = (s << 6) + 63 - std::countl_zero(sb);
+        return (lw << 6) + 63 - std::countl_zero(leaf_[lw]);
+      }
+      if (s == 0) return npos;
+      sb = summary_[--s];
+    }
+  }
+
+private:
+  static constexpr uint64_t bit(std::size_t i) { return uint64_t(1) << i; }
+
+  std::size_t size_;
+  std::pmr::vector<uint64_t> leaf_;
+  std::pmr::vector<uint64_t> summary_;
+};
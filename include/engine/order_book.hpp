@@ -0,0 +1,110 @@
+#pragma once
+
+#include "domain/order.hpp"
+#include "domain/price.hpp"
+#include "domain/side.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+// One resting order inside a price level (price/side live on the level/book).
+struct RestingOrder {
+  std::string order_id;
+  std::string client_id;
+  int64_t     quantity;
+};
+
+// FIFO queue of orders at one price.
+// A vector rather than a deque: an empty vector allocates nothing, which matters for the
+// tick ladder where most pre-allocated levels stay empty.
+struct PriceLevel {
+  explicit PriceLevel(std::pmr::memory_resource* mr) : orders(mr) {}
+
+  int64_t                        total_qty = 0;
+  std::pmr::vector<RestingOrder> orders;      // time priority: front is oldest
+};
+
+// Take one order out of a level (keeps FIFO order of the others).
+// Returns its quantity, or nullopt if the id isn't at this level.
+inline std::optional<int64_t> take_order(PriceLevel& level, const std::string& order_id) {
+  auto it = std::find_if(level.orders.begin(), level.orders.end(),
+                         [&](const RestingOrder& o) { return o.order_id == order_id; });
+  if (it == level.orders.end()) return std::nullopt;
+  const int64_t qty = it->quantity;
+  level.orders.erase(it);
+  level.total_qty -= qty;
+  return qty;
+}
+
+// In-memory limit order book for one symbol, price levels kept in ordered maps.
+// Notes:
+//  - Prices are Q4 integers (see normalize_to_q4), never doubles.
+//  - Nodes come from the given memory resource (the engine pool from RuntimeConfig).
+//  - Not thread-safe: the service serializes access (write_mu).
+class MapOrderBook {
+public:
+  explicit MapOrderBook(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+    : mr_(mr), bids_(mr), asks_(mr) {}
+
+  // Rest a LIMIT order at o.price_q4 (appended behind existing orders at that price).
+  void add(const Order& o) {
+    auto& level = (o.side == mat_eng::BUY) ? level_at(bids_, o.price_q4) : level_at(asks_, o.price_q4);
+    level.orders.push_back(RestingOrder{o.order_id, o.client_id, o.quantity});
+    level.total_qty += o.quantity;
+    ++order_count_;
+  }
+
+  // Remove a resting order (cancel). Returns its quantity, or nullopt if it isn't resting at px.
+  std::optional<int64_t> remove(Side side, PriceQ4 px, const std::string& order_id) {
+    auto r = (side == mat_eng::BUY) ? take_from(bids_, px, order_id) : take_from(asks_, px, order_id);
+    if (r) --order_count_;
+    return r;
+  }
+
+  std::optional<PriceQ4> best_bid() const {
+    if (bids_.empty()) return std::nullopt;
+    return bids_.begin()->first;
+  }
+  std::optional<PriceQ4> best_ask() const {
+    if (asks_.empty()) return std::nullopt;
+    return asks_.begin()->first;
+  }
+
+  // Visit non-empty levels of one side, best price first: f(PriceQ4, const PriceLevel&).
+  template <class F>
+  void for_each_level(Side side, F&& f) const {
+    if (side == mat_eng::BUY) { for (const auto& [px, lvl] : bids_) f(px, lvl); }
+    else                      { for (const auto& [px, lvl] : asks_) f(px, lvl); }
+  }
+
+  std::size_t order_count() const { return order_count_; }
+
+private:
+  template <class Map>
+  PriceLevel& level_at(Map& side, PriceQ4 px) {
+    auto it = side.find(px);
+    if (it == side.end()) it = side.emplace(px, PriceLevel(mr_)).first;
+    return it->second;
+  }
+
+  template <class Map>
+  static std::optional<int64_t> take_from(Map& side, PriceQ4 px, const std::string& order_id) {
+    auto it = side.find(px);
+    if (it == side.end()) return std::nullopt;
+    auto r = take_order(it->second, order_id);
+    if (r && it->second.orders.empty()) side.erase(it);
+    return r;
+  }
+
+  std::pmr::memory_resource* mr_;
+  std::pmr::map<PriceQ4, PriceLevel, std::greater<PriceQ4>> bids_;   // highest first
+  std::pmr::map<PriceQ4, PriceLevel, std::less<PriceQ4>>    asks_;   // lowest first
+  std::size_t order_count_ = 0;
+};
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "engine/occupancy_bitmap.hpp"
+#include "engine/order_book.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// One side of a tick-ladder book: price levels in a contiguous array indexed by
+// (price - base) / tick, plus an occupancy bitmap to jump between non-empty levels.
+// Notes:
+//  - base is chosen on the first order and moved ("recentered") when a price lands outside
+//    the window and everything resting still fits in `ticks` levels around it.
+//  - Prices that can't fit (book wider than the window, not a multiple of tick, or negative)
+//    rest in a small ordered map instead. Invariant: a price lives either in the ladder or
+//    in the map.
+//  - Recentering shifts levels in place, O(ticks/64 + occupied levels), and allocates nothing;
+//    it's meant to be rare (the window is re-centred on the book).
+//  - The best ladder index is cached, so top of book is one load; the bitmap is what finds
+//    the next level when walking the book (and the new best once a level empties).
+class TickLadder {
+public:
+  TickLadder(bool is_bid, PriceQ4 tick, std::size_t ticks, std::pmr::memory_resource* mr)
+    : is_bid_(is_bid), tick_(tick), mr_(mr),
+      levels_(make_levels(ticks)), occ_(ticks, mr), spare_(ticks, mr), overflow_(mr) {}
+
+  // Level for px, created (and marked occupied) if needed.
+  PriceLevel& level_for(PriceQ4 px) {
+    std::size_t i;
+    if (index_of(px, i) || (recenter(px) && index_of(px, i))) {
+      occ_.set(i);
+      if (best_ == OccupancyBitmap::npos || (is_bid_ ? i > best_ : i < best_)) best_ = i;
+      return levels_[i];
+    }
+    return overflow_.try_emplace(px, PriceLevel(mr_)).first->second;
+  }
+
+  // Remove order_id from the level at px. An emptied ladder level clears its bitmap bit and,
+  // if it was the best, the bitmap finds the next one.
+  std::optional<int64_t> remove(PriceQ4 px, const std::string& order_id) {
+    std::size_t i;
+    if (index_of(px, i)) {
+      if (!occ_.test(i)) return std::nullopt;
+      auto r = take_order(levels_[i], order_id);
+      if (r && levels_[i].orders.empty()) {
+        occ_.clear(i);
+        if (i == best_) best_ = is_bid_ ? occ_.prev(i) : occ_.next(i);
+      }
+      return r;
+    }
+    auto it = overflow_.find(px);
+    if (it == overflow_.end()) return std::nullopt;
+    auto r = take_order(it->second, order_id);
+    if (r && it->second.orders.empty()) overflow_.erase(it);
+    return r;
+  }
+
+  // Plain branches on purpose: merging two std::optional temporaries compiles to partial
+  // stores + wide reloads (store-forwarding stalls), ~15x slower on the hot path.
+  std::optional<PriceQ4> best() const {
+    if (overflow_.empty()) {
+      if (best_ == OccupancyBitmap::npos) return std::nullopt;
+      return price_at(best_);
+    }
+    const PriceQ4 spill = is_bid_ ? std::prev(overflow_.end())->first : overflow_.begin()->first;
+    if (best_ == OccupancyBitmap::npos) return spill;
+    const PriceQ4 ladder = price_at(best_);
+    return is_bid_ ? std::max(ladder, spill) : std::min(ladder, spill);
+  }
+
+  // Non-empty levels, best first: f(PriceQ4, const PriceLevel&). Merges ladder and overflow.
+  template <class F>
+  void for_each_level(F&& f) const {
+    if (is_bid_) walk(best_, overflow_.rbegin(), overflow_.rend(), f);
+    else         walk(best_, overflow_.begin(),  overflow_.end(),  f);
+  }
+
+  std::size_t overflow_levels() const { return overflow_.size(); }
+  PriceQ4 base() const { return base_; }
+
+private:
+  // emplace one by one: copying a prototype level would drop mr_ (pmr copies use the default resource)
+  std::pmr::vector<PriceLevel> make_levels(std::size_t n) const {
+    std::pmr::vector<PriceLevel> v(mr_);
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) v.emplace_back(mr_);
+    return v;
+  }
+
+  PriceQ4 price_at(std::size_t i) const { return base_ + static_cast<PriceQ4>(i) * tick_; }
+
+  // base_ >= 0, so px - base_ can't overflow once px >= base_
+  bool index_of(PriceQ4 px, std::size_t& i) const {
+    if (!anchored_ || px < base_ || (px - base_) % tick_ != 0) return false;
+    const auto off = static_cast<uint64_t>((px - base_) / tick_);
+    if (off >= levels_.size()) return false;
+    i = static_cast<std::size_t>(off);
+    return true;
+  }
+
+  std::size_t step(std::size_t i) const { return is_bid_ ? occ_.prev(i - 1) : occ_.next(i + 1); }
+
+  template <class It, class F>
+  void walk(std::size_t i, It it, It end, F& f) const {
+    auto better = [this](PriceQ4 a, PriceQ4 b) { return is_bid_ ? a > b : a < b; };
+    while (i != OccupancyBitmap::npos || it != end) {
+      if (it == end || (i != OccupancyBitmap::npos && better(price_at(i), it->first))) {
+        f(price_at(i), levels_[i]);
+        i = step(i);   // prev(npos) is npos, so i == 0 ends the bid side cleanly
+      } else {
+        f(it->first, it->second);
+        ++it;
+      }
+    }
+  }
+
+  // Move the window so that px and every occupied ladder level fit. False if they can't.
+  // The window stays inside [0, INT64_MAX] (negative prices live in the overflow map), so
+  // no offset or level price computed from base_ can overflow.
+  bool recenter(PriceQ4 px) {
+    if (px < 0 || px % tick_ != 0) return false;
+    const auto n = static_cast<PriceQ4>(levels_.size());
+
+    PriceQ4 lo = px, hi = px;
+    if (!occ_.empty()) {
+      lo = std::min(lo, price_at(occ_.first()));
+      hi = std::max(hi, price_at(occ_.last()));
+    }
+    if ((hi - lo) / tick_ >= n) return false;
+
+    // Center on the occupied range, aligned to the tick, without leaving [0, max_base]
+    const PriceQ4 width    = (n - 1) * tick_;   // window is [base, base + width]
+    const PriceQ4 max_base = (std::numeric_limits<PriceQ4>::max() - width) / tick_ * tick_;
+    const PriceQ4 mid      = lo + (hi - lo) / 2;
+    PriceQ4 new_base = mid - std::min(mid, (n / 2) * tick_);
+    new_base -= new_base % tick_;
+    new_base = std::min(new_base, max_base);
+    if (hi - new_base > width) new_base = hi - width;
+
+    // Shift levels within the array (no reallocation: with a monotonic arena under the pool,
+    // a fresh ticks-sized array per recenter would never be given back). Walk in the direction
+    // of the shift so each target slot is already empty; swapping leaves the source empty.
+    const std::ptrdiff_t shift = anchored_ ? static_cast<std::ptrdiff_t>((new_base - base_) / tick_) : 0;
+    spare_.reset();
+    const auto move_level = [&](std::size_t i) {
+      const auto j = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(i) - shift);
+      if (j != i) std::swap(levels_[j], levels_[i]);
+      spare_.set(j);
+    };
+    if (shift > 0) {
+      for (std::size_t i = occ_.first(); i != OccupancyBitmap::npos; i = occ_.next(i + 1)) move_level(i);
+    } else {
+      for (std::size_t i = occ_.last(); i != OccupancyBitmap::npos; i = i == 0 ? OccupancyBitmap::npos : occ_.prev(i - 1))
+        move_level(i);
+    }
+    std::swap(occ_, spare_);
+    base_     = new_base;
+    anchored_ = true;
+
+    // Overflow prices now inside the window move into the ladder (keeps the invariant)
+    for (auto it = overflow_.begin(); it != overflow_.end();) {
+      std::size_t j;
+      if (index_of(it->first, j)) {
+        std::swap(levels_[j], it->second);
+        occ_.set(j);
+        it = overflow_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    best_ = is_bid_ ? occ_.last() : occ_.first();
+    return true;
+  }
+
+  bool    is_bid_;
+  PriceQ4 tick_;
+  std::pmr::memory_resource* mr_;
+
+  bool    anchored_ = false;   // base_ is meaningless until the first order
+  PriceQ4 base_     = 0;
+  std::size_t best_ = OccupancyBitmap::npos;   // best occupied ladder index (highest bid / lowest ask)
+  std::pmr::vector<PriceLevel> levels_;
+  OccupancyBitmap occ_;
+  OccupancyBitmap spare_;   // scratch for recenter, swapped with occ_
+  std::pmr::map<PriceQ4, PriceLevel> overflow_;   // ascending
+};
+
+// Order book for one symbol with a dense tick ladder per side (see TickLadder).
+// Same interface as MapOrderBook. Best price is a ctz/clz away; inserting at an existing or
+// nearby price touches one array slot and one bitmap word instead of walking a tree.
+class TickLadderBook {
+public:
+  static constexpr std::size_t kDefaultTicks = 4096;
+
+  explicit TickLadderBook(std::pmr::memory_resource* mr = std::pmr::get_default_resource(),
+                          std::size_t ticks = kDefaultTicks,
+                          PriceQ4 tick = 1)
+    : bids_(true, tick, ticks, mr), asks_(false, tick, ticks, mr) {}
+
+  void add(const Order& o) {
+    PriceLevel& level = (o.side == mat_eng::BUY) ? bids_.level_for(o.price_q4) : asks_.level_for(o.price_q4);
+    level.orders.push_back(RestingOrder{o.order_id, o.client_id, o.quantity});
+    level.total_qty += o.quantity;
+    ++order_count_;
+  }
+
+  std::optional<int64_t> remove(Side side, PriceQ4 px, const std::string& order_id) {
+    auto r = (side == mat_eng::BUY) ? bids_.remove(px, order_id) : asks_.remove(px, order_id);
+    if (r) --order_count_;
+    return r;
+  }
+
+  std::optional<PriceQ4> best_bid() const { return bids_.best(); }
+  std::optional<PriceQ4> best_ask() const { return asks_.best(); }
+
+  template <class F>
+  void for_each_level(Side side, F&& f) const {
+    if (side == mat_eng::BUY) bids_.for_each_level(f);
+    else                      asks_.for_each_level(f);
+  }
+
+  std::size_t order_count() const { return order_count_; }
+
+  const TickLadder& bids() const { return bids_; }
+  const TickLadder& asks() const { return asks_; }
+
+private:
+  TickLadder bids_;
+  TickLadder asks_;
+  std::size_t order_count_ = 0;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <grpcpp/grpcpp.h>
+#include "matching_engine.grpc.pb.h"
+#include "gateway/symbol_router.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mat_eng = matching_engine::v1;
+
+// Stateless front door exposing the same MatchingEngine service as `server`.
+// Each request is forwarded to the backend that owns its symbol (see SymbolRouter);
+// StreamOrderUpdates is fanned out to every backend and merged into one stream.
+// `server` (MatchingEngineServiceImpl) doesn't implement the two streaming RPCs yet, so
+// against it both streams end with the backend's UNIMPLEMENTED.
+//
+// Backends number their orders independently, so order ids leaving the gateway are qualified
+// with the backend index ("<backend>:<order_id>", e.g. "1:OID-42") to keep them unique.
+class GatewayServiceImpl final : public mat_eng::MatchingEngine::Service {
+public:
+  GatewayServiceImpl(std::vector<std::string> backend_addrs, SymbolRouter router);
+
+  GatewayServiceImpl(const GatewayServiceImpl&)            = delete;
+  GatewayServiceImpl& operator=(const GatewayServiceImpl&) = delete;
+
+  grpc::Status SubmitOrder(grpc::ServerContext*,
+                           const mat_eng::OrderRequest*,
+                           mat_eng::OrderResponse*) override;
+
+  grpc::Status CancelOrder(grpc::ServerContext*,
+                           const mat_eng::CancelRequest*,
+                           mat_eng::CancelResponse*) override;
+
+  grpc::Status GetOrderBook(grpc::ServerContext*,
+                            const mat_eng::OrderBookRequest*,
+                            mat_eng::OrderBookResponse*) override;
+
+  grpc::Status StreamMarketData(grpc::ServerContext*,
+                                const mat_eng::MarketDataRequest*,
+                                grpc::ServerWriter<mat_eng::MarketDataUpdate>*) override;
+
+  grpc::Status StreamOrderUpdates(grpc::ServerContext*,
+                                  const mat_eng::OrderUpdatesRequest*,
+                                  grpc::ServerWriter<mat_eng::OrderUpdate>*) override;
+
+  static std::string qualify_order_id(std::size_t backend, const std::string& order_id);
+  // Inverse of qualify_order_id. False if the id has no "<backend>:" prefix.
+  static bool split_order_id(const std::string& qualified, std::size_t& backend, std::string& order_id);
+
+private:
+  std::vector<std::unique_ptr<mat_eng::MatchingEngine::Stub>> backends_;
+  SymbolRouter router_;
+};
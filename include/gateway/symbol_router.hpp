@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Maps a symbol to one of N backend engine processes.
+// Notes:
+//  - Static routes (pin("AAPL", 2)) win; every other symbol goes through a consistent-hash ring.
+//  - The ring is built from backend *indexes*, not addresses, so moving a backend to another
+//    host:port doesn't reshuffle symbols. Adding a backend only moves ~1/N of the symbols.
+//  - The hash (FNV-1a 64 + fmix64) is fixed so every gateway instance computes the same placement.
+//  - Not thread-safe for writes; build it once at startup, then route() concurrently.
+class SymbolRouter {
+public:
+  explicit SymbolRouter(std::size_t backend_count, int virtual_nodes = 64);
+
+  std::size_t backend_count() const { return backend_count_; }
+
+  // Static route. Throws std::out_of_range if backend >= backend_count().
+  void pin(const std::string& symbol, std::size_t backend);
+
+  // Backend index owning this symbol.
+  std::size_t route(const std::string& symbol) const;
+
+  static uint64_t hash(const std::string& s);
+
+private:
+  std::size_t backend_count_;
+  std::unordered_map<std::string, std::size_t> static_;
+  std::vector<std::pair<uint64_t, std::size_t>> ring_;   // sorted by hash
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "order_entry/protocol.hpp"
+
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace oe {
+
+// Blocking client for the binary order-entry protocol (POSIX sockets).
+// Notes:
+//  - send() only encodes into a local buffer; flush() writes everything queued in one go,
+//    so a burst of orders costs one syscall. read() flushes first.
+//  - Replies come back in request order per connection (match them on client_seq).
+//  - Errors (connect failure, disconnect, malformed reply) throw std::runtime_error.
+//  - send() throws std::invalid_argument for a client_id or symbol wider than its wire field
+//    (16 / 12 bytes) instead of truncating it; nothing is queued then.
+//  - Not thread-safe: use one client per thread.
+class Client {
+public:
+  using Message = std::variant<Ack, Reject, Fill>;
+
+  static Client connect_tcp(const std::string& host, int port);
+  static Client connect_unix(const std::string& path);
+
+  ~Client();
+  Client(Client&& other) noexcept;
+  Client& operator=(Client&& other) noexcept;
+  Client(const Client&)            = delete;
+  Client& operator=(const Client&) = delete;
+
+  void send(const NewOrder& m);
+  void send(const CancelOrder& m);
+  void flush();
+
+  // Next message from the server (blocks until one arrives).
+  Message read();
+
+private:
+  explicit Client(int fd) : fd_(fd) {}
+
+  template <class Msg>
+  void queue(const Msg& m);
+
+  int fd_ = -1;
+  std::vector<uint8_t> out_;
+  std::vector<uint8_t> in_;
+  std::size_t in_off_ = 0;   // first unparsed byte of in_
+};
+
+} // namespace oe
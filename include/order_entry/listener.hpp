@@ -0,0 +1,57 @@
+#pragma once
+
+#include "runtime/runtime_config.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class MatchingEngineServiceImpl;
+
+struct OrderEntryConfig {
+  std::string tcp_addr;    // "host:port" (port 0 picks a free one); empty = no TCP endpoint
+  std::string unix_path;   // path of a Unix stream socket (replaced if it exists); empty = none
+};
+
+// Binary order-entry endpoint (see order_entry/protocol.hpp) that calls straight into the
+// engine service: no HTTP/2 framing, no protobuf, no gRPC thread handoff.
+// Notes:
+//  - Linux only (epoll). A single event-loop thread owns the listening sockets and every
+//    connection; sockets are non-blocking, TCP ones with TCP_NODELAY.
+//  - Each readable socket is drained with large reads and every complete frame is handled
+//    before anything is written, so replies to a pipelined burst leave in one send().
+//  - A reply that doesn't fit in the socket buffer is kept and finished on EPOLLOUT. Until then
+//    the connection is not read (EPOLLOUT only), and at most 64 KB of unsent replies are
+//    produced per connection, so a client that sends without reading gets TCP backpressure
+//    instead of growing the server's buffers.
+//  - A malformed frame closes the connection (a fixed-layout stream can't be resynced).
+//  - The wait strategy decides how the loop idles: epoll_wait(-1) when Blocking,
+//    epoll_wait(0) polling (+ yield for SpinYield) otherwise.
+//  - Orders go through the same SubmitOrder/CancelOrder paths as gRPC (validation, storage,
+//    replication), synchronously and one at a time on the loop thread: every connection waits
+//    behind each order's SQLite write. Throughput is bounded by that write, not by the socket.
+//    Sync replication (--repl-sync) would add a standby round trip per order to that, so the
+//    server refuses to combine it with binary order entry.
+class OrderEntryListener {
+public:
+  OrderEntryListener(MatchingEngineServiceImpl& engine,
+                     OrderEntryConfig cfg,
+                     WaitStrategy wait = WaitStrategy::Blocking,
+                     std::vector<int> cpus = {});
+  ~OrderEntryListener();   // stops the loop and closes every socket
+
+  OrderEntryListener(const OrderEntryListener&)            = delete;
+  OrderEntryListener& operator=(const OrderEntryListener&) = delete;
+
+  // Bind the configured endpoints and start the loop thread.
+  // Throws std::runtime_error if an endpoint can't be bound.
+  void start();
+  void stop();
+
+  // Port actually bound for tcp_addr (useful with port 0), 0 if there is no TCP endpoint.
+  int tcp_port() const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> d_;
+};
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Fixed-layout binary order-entry protocol (SBE/OUCH style).
+// Notes:
+//  - Every message is a 4-byte header followed by a fixed-size body; all integers are
+//    little-endian, strings are fixed-width and NUL padded. No varints, no optional fields.
+//  - Header: u16 length (whole message, header included), u8 type, u8 version.
+//  - Prices on the wire are raw price + scale exactly like OrderRequest; the engine normalizes
+//    them to Q4. Acks/fills carry Q4 prices.
+//  - Order ids on the wire are the numeric part of the engine id ("OID-42" -> 42).
+//  - Both directions are pipelined: the client may send many messages before reading.
+//
+// Client -> server: NewOrder, CancelOrder.  Server -> client: Ack, Reject, Fill.
+
+namespace oe {
+
+inline constexpr uint8_t kVersion = 1;
+
+enum class MsgType : uint8_t {
+  NewOrder    = 1,
+  CancelOrder = 2,
+  Ack         = 3,
+  Reject      = 4,
+  Fill        = 5,
+};
+
+enum class RejectReason : uint16_t {
+  Invalid       = 1,   // failed validation (same checks as SubmitOrder)
+  UnknownOrder  = 2,   // cancel of an order that isn't resting
+  NotPrimary    = 3,   // this engine is a standby
+  Throttled     = 4,   // admission control; see retry_after_ms
+  Internal      = 5,   // storage failure
+  NotReplicated = 6,   // --repl-sync timeout: order withdrawn, or cancel done here but unconfirmed
+};
+
+inline constexpr std::size_t kHeaderSize    = 4;
+inline constexpr std::size_t kClientIdLen   = 16;
+inline constexpr std::size_t kSymbolLen     = 12;
+inline constexpr std::size_t kRejectTextLen = 48;
+
+inline constexpr std::size_t kNewOrderSize    = kHeaderSize + 52;
+inline constexpr std::size_t kCancelOrderSize = kHeaderSize + 32;
+inline constexpr std::size_t kAckSize         = kHeaderSize + 20;
+inline constexpr std::size_t kRejectSize      = kHeaderSize + 64;
+inline constexpr std::size_t kFillSize        = kHeaderSize + 24;
+inline constexpr std::size_t kMaxMessageSize  = kRejectSize;
+
+// ------------------------------ messages ------------------------------
+
+struct NewOrder {
+  uint64_t    client_seq = 0;   // client's own token, echoed in Ack/Reject
+  std::string client_id;        // <= 16 chars
+  std::string symbol;           // <= 12 chars
+  uint8_t     side       = 0;   // 1=BUY, 2=SELL (matches proto Side)
+  uint8_t     order_type = 0;   // 0=LIMIT, 1=MARKET (matches proto OrderType)
+  uint8_t     scale      = 0;
+  int64_t     price      = 0;   // raw, see scale
+  int32_t     quantity   = 0;
+};
+
+struct CancelOrder {
+  uint64_t    client_seq = 0;
+  uint64_t    order_id   = 0;
+  std::string client_id;        // must own the order
+};
+
+struct Ack {
+  uint64_t client_seq = 0;
+  uint64_t order_id   = 0;
+  MsgType  acked      = MsgType::NewOrder;   // which request this confirms
+};
+
+struct Reject {
+  uint64_t     client_seq     = 0;
+  RejectReason reason         = RejectReason::Invalid;
+  uint32_t     retry_after_ms = 0;           // only meaningful for Throttled
+  std::string  text;                         // truncated to 48 chars
+};
+
+struct Fill {
+  uint64_t order_id  = 0;
+  int64_t  price_q4  = 0;
+  int32_t  quantity  = 0;
+  int32_t  remaining = 0;
+};
+
+// ------------------------------ little-endian helpers ------------------------------
+// Byte-by-byte so the layout doesn't depend on host endianness or struct packing;
+// compilers turn these into single loads/stores on little-endian targets.
+
+namespace detail {
+
+template <class T>
+inline void put(uint8_t* p, T v) {
+  using U = std::make_unsigned_t<T>;
+  U u = static_cast<U>(v);
+  for (std::size_t i = 0; i < sizeof(T); ++i) { p[i] = static_cast<uint8_t>(u & 0xFF); u >>= 8; }
+}
+
+template <class T>
+inline T get(const uint8_t* p) {
+  using U = std::make_unsigned_t<T>;
+  U u = 0;
+  for (std::size_t i = sizeof(T); i-- > 0;) u = static_cast<U>((u << 8) | p[i]);
+  return static_cast<T>(u);
+}
+
+inline void put_str(uint8_t* p, const std::string& s, std::size_t width) {
+  std::memset(p, 0, width);
+  std::memcpy(p, s.data(), s.size() < width ? s.size() : width);
+}
+
+inline std::string get_str(const uint8_t* p, std::size_t width) {
+  std::size_t n = 0;
+  while (n < width && p[n] != 0) ++n;
+  return std::string(reinterpret_cast<const char*>(p), n);
+}
+
+inline void put_header(uint8_t* p, std::size_t size, MsgType type) {
+  put<uint16_t>(p, static_cast<uint16_t>(size));
+  p[2] = static_cast<uint8_t>(type);
+  p[3] = kVersion;
+}
+
+} // namespace detail
+
+// ------------------------------ framing ------------------------------
+
+inline std::size_t message_size(MsgType t) {
+  switch (t) {
+    case MsgType::NewOrder:    return kNewOrderSize;
+    case MsgType::CancelOrder: return kCancelOrderSize;
+    case MsgType::Ack:         return kAckSize;
+    case MsgType::Reject:      return kRejectSize;
+    case MsgType::Fill:        return kFillSize;
+  }
+  return 0;
+}
+
+// Result of peeking at the start of a receive buffer.
+enum class Frame { Incomplete, Ready, Malformed };
+
+// Ready when [p, p+avail) starts with a whole, well-formed message; sets type/size.
+inline Frame peek_frame(const uint8_t* p, std::size_t avail, MsgType& type, std::size_t& size) {
+  if (avail < kHeaderSize) return Frame::Incomplete;
+  size = detail::get<uint16_t>(p);
+  type = static_cast<MsgType>(p[2]);
+  if (p[3] != kVersion || message_size(type) == 0 || message_size(type) != size) return Frame::Malformed;
+  return avail < size ? Frame::Incomplete : Frame::Ready;
+}
+
+// ------------------------------ encode (buffer must hold message_size bytes) ------------------------------
+
+inline std::size_t encode(const NewOrder& m, uint8_t* p) {
+  using namespace detail;
+  put_header(p, kNewOrderSize, MsgType::NewOrder);
+  uint8_t* b = p + kHeaderSize;
+  put<uint64_t>(b + 0, m.client_seq);
+  put_str(b + 8,  m.client_id, kClientIdLen);
+  put_str(b + 24, m.symbol,    kSymbolLen);
+  b[36] = m.side;
+  b[37] = m.order_type;
+  b[38] = m.scale;
+  b[39] = 0;
+  put<int64_t>(b + 40, m.price);
+  put<int32_t>(b + 48, m.quantity);
+  return kNewOrderSize;
+}
+
+inline std::size_t encode(const CancelOrder& m, uint8_t* p) {
+  using namespace detail;
+  put_header(p, kCancelOrderSize, MsgType::CancelOrder);
+  uint8_t* b = p + kHeaderSize;
+  put<uint64_t>(b + 0, m.client_seq);
+  put<uint64_t>(b + 8, m.order_id);
+  put_str(b + 16, m.client_id, kClientIdLen);
+  return kCancelOrderSize;
+}
+
+inline std::size_t encode(const Ack& m, uint8_t* p) {
+  using namespace detail;
+  put_header(p, kAckSize, MsgType::Ack);
+  uint8_t* b = p + kHeaderSize;
+  put<uint64_t>(b + 0, m.client_seq);
+  put<uint64_t>(b + 8, m.order_id);
+  b[16] = static_cast<uint8_t>(m.acked);
+  b[17] = b[18] = b[19] = 0;
+  return kAckSize;
+}
+
+inline std::size_t encode(const Reject& m, uint8_t* p) {
+  using namespace detail;
+  put_header(p, kRejectSize, MsgType::Reject);
+  uint8_t* b = p + kHeaderSize;
+  put<uint64_t>(b + 0,  m.client_seq);
+  put<uint16_t>(b + 8,  static_cast<uint16_t>(m.reason));
+  put<uint16_t>(b + 10, 0);
+  put<uint32_t>(b + 12, m.retry_after_ms);
+  put_str(b + 16, m.text, kRejectTextLen);
+  return kRejectSize;
+}
+
+inline std::size_t encode(const Fill& m, uint8_t* p) {
+  using namespace detail;
+  put_header(p, kFillSize, MsgType::Fill);
+  uint8_t* b = p + kHeaderSize;
+  put<uint64_t>(b + 0,  m.order_id);
+  put<int64_t>(b + 8,   m.price_q4);
+  put<int32_t>(b + 16,  m.quantity);
+  put<int32_t>(b + 20,  m.remaining);
+  return kFillSize;
+}
+
+// ------------------------------ decode (p points at a Ready frame of that type) ------------------------------
+
+inline NewOrder decode_new_order(const uint8_t* p) {
+  using namespace detail;
+  const uint8_t* b = p + kHeaderSize;
+  NewOrder m;
+  m.client_seq = get<uint64_t>(b + 0);
+  m.client_id  = get_str(b + 8,  kClientIdLen);
+  m.symbol     = get_str(b + 24, kSymbolLen);
+  m.side       = b[36];
+  m.order_type = b[37];
+  m.scale      = b[38];
+  m.price      = get<int64_t>(b + 40);
+  m.quantity   = get<int32_t>(b + 48);
+  return m;
+}
+
+inline CancelOrder decode_cancel_order(const uint8_t* p) {
+  using namespace detail;
+  const uint8_t* b = p + kHeaderSize;
+  return CancelOrder{get<uint64_t>(b + 0), get<uint64_t>(b + 8), get_str(b + 16, kClientIdLen)};
+}
+
+inline Ack decode_ack(const uint8_t* p) {
+  using namespace detail;
+  const uint8_t* b = p + kHeaderSize;
+  return Ack{get<uint64_t>(b + 0), get<uint64_t>(b + 8), static_cast<MsgType>(b[16])};
+}
+
+inline Reject decode_reject(const uint8_t* p) {
+  using namespace detail;
+  const uint8_t* b = p + kHeaderSize;
+  Reject m;
+  m.client_seq     = get<uint64_t>(b + 0);
+  m.reason         = static_cast<RejectReason>(get<uint16_t>(b + 8));
+  m.retry_after_ms = get<uint32_t>(b + 12);
+  m.text           = get_str(b + 16, kRejectTextLen);
+  return m;
+}
+
+inline Fill decode_fill(const uint8_t* p) {
+  using namespace detail;
+  const uint8_t* b = p + kHeaderSize;
+  return Fill{get<uint64_t>(b + 0), get<int64_t>(b + 8), get<int32_t>(b + 16), get<int32_t>(b + 20)};
+}
+
+// "OID-42" <-> 42 (0 if the id doesn't have the engine's format)
+inline uint64_t wire_order_id(const std::string& order_id) {
+  if (order_id.rfind("OID-", 0) != 0 || order_id.size() == 4) return 0;
+  uint64_t v = 0;
+  for (std::size_t i = 4; i < order_id.size(); ++i) {
+    if (order_id[i] < '0' || order_id[i] > '9') return 0;
+    v = v * 10 + static_cast<uint64_t>(order_id[i] - '0');
+  }
+  return v;
+}
+
+inline std::string engine_order_id(uint64_t wire_id) { return "OID-" + std::to_string(wire_id); }
+
+} // namespace oe
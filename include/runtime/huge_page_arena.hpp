@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// Fixed-size memory region for engine pools, optionally backed by huge pages.
+// Notes:
+//  - Huge pages are best effort: if the OS refuses (no hugetlbfs pages reserved, missing
+//    SeLockMemoryPrivilege on Windows, ...) we fall back to normal pages and say so on stderr.
+//  - With prefault=true every page is touched in the constructor, so the hot path never takes
+//    a page fault on first use.
+//  - resource() hands out a pool allocator carved from the region; when the region is exhausted
+//    it spills over to the default heap rather than failing.
+//  - resource() is NOT thread-safe; use it from the thread(s) that own the engine (under write_mu).
+class HugePageArena {
+public:
+  HugePageArena(std::size_t bytes, bool huge_pages, bool prefault);
+  ~HugePageArena();
+
+  HugePageArena(const HugePageArena&)            = delete;
+  HugePageArena& operator=(const HugePageArena&) = delete;
+
+  std::size_t size() const { return size_; }
+  bool uses_huge_pages() const { return huge_; }
+
+  std::pmr::memory_resource* resource() { return pool_.get(); }
+
+private:
+  void*       base_ = nullptr;
+  std::size_t size_ = 0;
+  bool        huge_ = false;
+
+  std::unique_ptr<std::pmr::monotonic_buffer_resource>  region_;
+  std::unique_ptr<std::pmr::unsynchronized_pool_resource> pool_;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// How a consumer waits on a queue/handoff when there is nothing to do.
+enum class WaitStrategy {
+  Blocking,      // condition variable / blocking syscall (default, lowest CPU)
+  SpinYield,     // spin for a bounded number of iterations, then yield
+  BusySpin,      // never give up the core (use on isolated CPUs only)
+};
+
+// In-memory order book layout, chosen per symbol.
+enum class BookLayout {
+  Map,           // ordered map of price levels (any price range)
+  TickLadder,    // dense array of levels around mid + occupancy bitmap (liquid, tight books)
+};
+
+// Low-latency runtime profile.
+// Notes:
+//  - Every field has a "do nothing" default, so an empty config behaves exactly like before.
+//  - Set from a key=value file (--config) and/or repeated --rt key=value flags (flags win).
+//  - CPU lists are comma separated ("2,3"); an empty list means "don't pin".
+//
+// Keys:
+//   cpu.io            = 2,3      gRPC handler / socket I/O threads
+//   cpu.engine        = 4        binary order-entry loop (runs engine code end to end); falls back to cpu.io
+//   cpu.persistence   = 5        thread(s) writing to storage / replication
+//   wait.default      = blocking | spin_yield | busy_spin
+//   wait.<queue>      = ...      per-queue override (wait.replication, wait.order_entry)
+//   memory.huge_pages = true     back the engine pool with huge pages (falls back to normal pages)
+//   memory.pool_mb    = 64       size of the engine pool, 0 disables it
+//   memory.prefault   = true     touch every page at startup so the hot path never page-faults
+//   book.layout       = map | tick_ladder      default layout for every symbol
+//   book.layout.<SYM> = map | tick_ladder      per-symbol override (e.g. book.layout.AAPL)
+//   book.ladder_ticks = 4096     width of the tick ladder window (in Q4 ticks)
+//   admission.shards       = 1     ingress shards (orders are assigned by symbol hash)
+//   admission.max_inflight = 64    orders admitted but not answered, per shard; 0 = unbounded
+//   admission.client_rate  = 500   orders/s per client_id (token bucket); 0 = unlimited
+//   admission.client_burst = 50    bucket size; 0 = one second worth of client_rate
+struct RuntimeConfig {
+  std::vector<int> io_cpus;
+  std::vector<int> engine_cpus;
+  std::vector<int> persistence_cpus;
+
+  WaitStrategy                        default_wait = WaitStrategy::Blocking;
+  std::map<std::string, WaitStrategy> queue_wait;   // queue name -> strategy
+
+  bool        huge_pages = false;
+  std::size_t pool_bytes = 0;
+  bool        prefault   = true;
+
+  BookLayout                        default_layout = BookLayout::Map;
+  std::map<std::string, BookLayout> symbol_layout;   // symbol -> layout
+  std::size_t                       ladder_ticks   = 4096;
+
+  std::size_t admission_shards       = 1;
+  std::size_t admission_max_inflight = 0;
+  double      admission_client_rate  = 0.0;
+  double      admission_client_burst = 0.0;
+
+  // Strategy for a named queue (falls back to default_wait).
+  WaitStrategy wait_for(const std::string& queue) const {
+    auto it = queue_wait.find(queue);
+    return it == queue_wait.end() ? default_wait : it->second;
+  }
+
+  // Layout for a symbol (falls back to default_layout).
+  BookLayout layout_for(const std::string& symbol) const {
+    auto it = symbol_layout.find(symbol);
+    return it == symbol_layout.end() ? default_layout : it->second;
+  }
+
+  // Apply one "key=value" setting. Throws std::invalid_argument on unknown keys/bad values.
+  void set(const std::string& key, const std::string& value);
+
+  // Parse a config file (one key=value per line, '#' starts a comment).
+  // Throws std::runtime_error if the file can't be opened, std::invalid_argument on bad lines.
+  void load_file(const std::string& path);
+};
+
+WaitStrategy parse_wait_strategy(const std::string& s);
+const char*  to_string(WaitStrategy w);
+BookLayout   parse_book_layout(const std::string& s);
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <vector>
+
+// Pin the calling thread to the given CPUs.
+// Returns false if the list is empty or the OS refused (the thread keeps floating in that case).
+bool pin_current_thread(const std::vector<int>& cpus);
+
+// Pin the calling thread once; later calls on the same thread are no-ops.
+// Meant for threads we don't create ourselves (e.g. gRPC handler threads).
+void pin_current_thread_once(const std::vector<int>& cpus);
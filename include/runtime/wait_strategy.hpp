@@ -0,0 +1,61 @@
+#pragma once
+
+#include "runtime/runtime_config.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+  #define ME_CPU_RELAX() _mm_pause()
+#elif defined(__x86_64__) || defined(__i386__)
+  #define ME_CPU_RELAX() __builtin_ia32_pause()
+#else
+  #define ME_CPU_RELAX() ((void)0)
+#endif
+
+// Wait until pred() is true, using the configured strategy.
+// pred is evaluated while holding lk (same contract as std::condition_variable::wait).
+// hint() is polled without lk, so it may only read atomics; it must be true whenever pred()
+// could be (false positives are fine, they just cost a lock round trip).
+//  - Blocking : plain cv.wait on pred, producers must notify cv. hint is unused.
+//  - SpinYield: drop lk and poll hint kSpinIters times, then yield between polls.
+//  - BusySpin : drop lk and poll hint forever (the core is burned on purpose).
+// The spinning modes retake lk only once hint() fires, so they don't fight producers for it.
+// Returns with lk held and pred() true, or false if the deadline expired first.
+template <class Hint, class Pred>
+bool wait_with(WaitStrategy ws,
+               std::unique_lock<std::mutex>& lk,
+               std::condition_variable& cv,
+               Hint hint,
+               Pred pred,
+               std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) {
+  if (ws == WaitStrategy::Blocking) {
+    if (deadline == std::chrono::steady_clock::time_point::max()) {
+      cv.wait(lk, pred);
+      return true;
+    }
+    return cv.wait_until(lk, deadline, pred);
+  }
+
+  constexpr int kSpinIters = 4096;
+  const bool timed = deadline != std::chrono::steady_clock::time_point::max();
+  int spins = 0;
+  while (!pred()) {
+    lk.unlock();
+    while (!hint()) {
+      if (ws == WaitStrategy::BusySpin || spins < kSpinIters) {
+        ME_CPU_RELAX();
+        ++spins;
+      } else {
+        std::this_thread::yield();
+      }
+      if (timed && std::chrono::steady_clock::now() >= deadline) break;
+    }
+    lk.lock();
+    if (timed && std::chrono::steady_clock::now() >= deadline) return pred();
+  }
+  return true;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "runtime/runtime_config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Trailing metadata key carrying the back-off hint on RESOURCE_EXHAUSTED (milliseconds).
+inline constexpr const char* kRetryAfterMetadataKey = "retry-after-ms";
+
+// Counters exposed for monitoring (monotonic except inflight).
+struct AdmissionStats {
+  uint64_t admitted          = 0;
+  uint64_t shed_shard_full   = 0;   // shard already had max_inflight orders in progress
+  uint64_t shed_rate_limited = 0;   // client_id ran out of tokens
+  uint64_t inflight          = 0;   // admitted, not answered yet (all shards)
+  uint64_t tracked_clients   = 0;   // token buckets currently held
+};
+
+// Decides, before any queueing, whether the engine takes an order now or sheds it.
+// Notes:
+//  - Ingress shards (by symbol hash) each allow at most max_inflight orders between
+//    admission and reply; everything past that is refused instead of piling up on the
+//    engine lock, so admitted orders keep a bounded wait.
+//  - Each client_id has a token bucket (client_rate/s, client_burst deep).
+//  - A refusal comes with a retry hint: time to the next token, or the average time a
+//    shard slot is held divided by the number of slots.
+//  - Lock-free for the shard check; buckets live in striped maps with a short lock each.
+//    Idle buckets are dropped a couple per call (never a full scan under the lock).
+//  - Default config (no limits) admits everything and only counts.
+class AdmissionController {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Verdict { Admitted, ShardFull, RateLimited };
+
+  // Outcome of admit(). An admitted ticket holds a shard slot until it is destroyed.
+  class Ticket {
+  public:
+    Ticket() = default;
+    ~Ticket() { release(); }
+    Ticket(Ticket&& o) noexcept { *this = std::move(o); }
+    Ticket& operator=(Ticket&& o) noexcept;
+    Ticket(const Ticket&)            = delete;
+    Ticket& operator=(const Ticket&) = delete;
+
+    bool     admitted()       const { return verdict_ == Verdict::Admitted; }
+    Verdict  verdict()        const { return verdict_; }
+    uint32_t retry_after_ms() const { return retry_after_ms_; }
+
+  private:
+    friend class AdmissionController;
+    void release();
+
+    AdmissionController* owner_ = nullptr;   // set while a slot is held
+    std::size_t       shard_    = 0;
+    Clock::time_point t0_{};
+    Verdict           verdict_        = Verdict::Admitted;
+    uint32_t          retry_after_ms_ = 0;
+  };
+
+  explicit AdmissionController(const RuntimeConfig& rt);
+
+  AdmissionController(const AdmissionController&)            = delete;
+  AdmissionController& operator=(const AdmissionController&) = delete;
+
+  Ticket admit(const std::string& client_id, const std::string& symbol, Clock::time_point now = Clock::now());
+
+  AdmissionStats stats() const;
+  std::size_t shard_of(const std::string& symbol) const { return std::hash<std::string>{}(symbol) % shard_count_; }
+
+private:
+  struct alignas(64) Shard {
+    std::atomic<uint32_t> inflight{0};
+    std::atomic<int64_t>  hold_ns{0};   // EWMA of admit -> release
+  };
+
+  struct Bucket {
+    double            tokens;
+    Clock::time_point last;
+  };
+
+  static constexpr std::size_t kStripes = 16;
+  struct alignas(64) Stripe {
+    std::mutex mu;
+    std::unordered_map<std::string, Bucket> buckets;   // client_id -> bucket
+    std::unordered_map<std::string, Bucket>::iterator sweep_at;   // next bucket to look at
+    bool sweeping = false;                                         // sweep_at is valid
+  };
+
+  void sweep_some(Stripe& stripe, Clock::time_point now);
+  bool take_token(const std::string& client_id, Clock::time_point now, uint32_t& retry_after_ms);
+  void release(std::size_t shard, Clock::time_point t0);
+
+  const std::size_t shard_count_;
+  const uint32_t    max_inflight_;   // 0 = unbounded
+  const double      rate_;           // tokens/s, 0 = unlimited
+  const double      burst_;
+
+  std::unique_ptr<Shard[]>  shards_;
+  std::unique_ptr<Stripe[]> stripes_;
+
+  std::atomic<uint64_t> admitted_{0};
+  std::atomic<uint64_t> shed_full_{0};
+  std::atomic<uint64_t> shed_rate_{0};
+};
@@ -1,14 +1,25 @@
 #pragma once
 #include <grpcpp/grpcpp.h>
 #include "matching_engine.grpc.pb.h"
+#include "runtime/runtime_config.hpp"
+#include "server/admission_control.hpp"
+#include "server/replicator.hpp"
 #include <memory>
 #include <string>
 
 namespace mat_eng = matching_engine::v1;
 
+// Why a cancel did or didn't happen, for front ends that map it to their own codes.
+enum class CancelOutcome {
+  Canceled,
+  UnknownOrder,    // never existed, filled, or already canceled
+  NotOwner,        // order belongs to another client
+  StorageFailed,   // DB update failed; the order is still resting
+};
+
 class MatchingEngineServiceImpl final : public mat_eng::MatchingEngine::Service {
 public:
-  explicit MatchingEngineServiceImpl(std::string db_path);
+  explicit MatchingEngineServiceImpl(std::string db_path, RuntimeConfig rt = {}, ReplicationConfig repl = {});
   ~MatchingEngineServiceImpl() override;                       // needed for pimpl
 
   MatchingEngineServiceImpl(const MatchingEngineServiceImpl&)            = delete;
@@ -20,10 +31,33 @@ public:
                            const mat_eng::OrderRequest*,
                            mat_eng::OrderResponse*) override;
 
+  // SubmitOrder without a gRPC context (in-process front ends such as binary order entry).
+  // When the order is shed (RESOURCE_EXHAUSTED), *retry_after_ms gets the back-off hint that
+  // gRPC clients receive in the kRetryAfterMetadataKey trailer.
+  grpc::Status SubmitOrderDirect(const mat_eng::OrderRequest&,
+                                 mat_eng::OrderResponse*,
+                                 uint32_t* retry_after_ms = nullptr);
+
+  grpc::Status CancelOrder(grpc::ServerContext*,
+                           const mat_eng::CancelRequest*,
+                           mat_eng::CancelResponse*) override;
+
+  // CancelOrder without a gRPC context; *outcome says why it failed (only set on Status::OK).
+  grpc::Status CancelOrderDirect(const mat_eng::CancelRequest&,
+                                 mat_eng::CancelResponse*,
+                                 CancelOutcome* outcome = nullptr);
+
   grpc::Status GetOrderBook(grpc::ServerContext*,
                             const mat_eng::OrderBookRequest*,
                             mat_eng::OrderBookResponse*) override;
 
+  AdmissionStats admission_stats() const;
+
+  // --- replication (driven by ReplicationServiceImpl) ---
+  bool is_primary() const;
+  grpc::Status ApplyReplicated(const mat_eng::ReplicationBatch&, mat_eng::ReplicationAck*);
+  grpc::Status Promote(mat_eng::PromoteResponse*);
+
 private:
   struct Impl;                    // forward-declared implementation
   std::unique_ptr<Impl> d_;       // pimpl
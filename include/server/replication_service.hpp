@@ -0,0 +1,24 @@
+#pragma once
+#include <grpcpp/grpcpp.h>
+#include "matching_engine.grpc.pb.h"
+#include "server/matching_engine_service.hpp"
+
+namespace mat_eng = matching_engine::v1;
+
+// gRPC front for the standby side of replication (Apply) and for failover (Promote).
+// Thin adapter: all state lives in MatchingEngineServiceImpl, which must outlive this object.
+class ReplicationServiceImpl final : public mat_eng::Replication::Service {
+public:
+  explicit ReplicationServiceImpl(MatchingEngineServiceImpl& engine) : engine_(engine) {}
+
+  grpc::Status Apply(grpc::ServerContext*,
+                     const mat_eng::ReplicationBatch*,
+                     mat_eng::ReplicationAck*) override;
+
+  grpc::Status Promote(grpc::ServerContext*,
+                       const mat_eng::PromoteRequest*,
+                       mat_eng::PromoteResponse*) override;
+
+private:
+  MatchingEngineServiceImpl& engine_;
+};
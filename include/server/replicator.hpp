@@ -0,0 +1,83 @@
+#pragma once
+#include <grpcpp/grpcpp.h>
+#include "matching_engine.grpc.pb.h"
+#include "runtime/runtime_config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mat_eng = matching_engine::v1;
+
+// Who this process is in a primary/standby pair.
+enum class ReplicationRole { Primary, Standby };
+
+struct ReplicationConfig {
+  ReplicationRole role = ReplicationRole::Primary;
+  std::string standby_addr;          // primary only: where to ship events ("unix:/tmp/me.sock", "127.0.0.1:50061")
+  std::string listen_addr;           // Replication service endpoint (own server, never on --addr); required for a standby
+  bool sync_ack = false;             // primary only: acknowledge orders only once the standby applied them
+  std::chrono::milliseconds ack_timeout{100};
+};
+
+// Ships engine events to the standby, in order, from a dedicated thread.
+// Notes:
+//  - publish() is called under the engine lock, so events are queued in engine order.
+//  - Whatever accumulated since the last send goes out as one batch (natural batching), capped at
+//    kMaxBatch events so a backlog never exceeds the standby's gRPC message limit.
+//  - At most kMaxBacklog events wait for the standby. Past that the backlog is dropped and
+//    nothing more is queued: the standby can only be rebuilt from the primary's db anyway, and
+//    sync acks fail at once instead of waiting out the timeout.
+//  - A failed send keeps the batch and retries with exponential backoff (also when the standby
+//    answers without progress); the standby drops seqs it already applied, so retries are idempotent.
+//  - The standby must be running before the primary takes orders: there is no snapshot/catch-up.
+//    A standby that missed events (e.g. restarted mid-stream) answers needs_resync; that is
+//    logged once; the fix is to copy the primary's db to the standby and restart both.
+class Replicator {
+public:
+  static constexpr std::size_t kMaxBatch   = 1024;      // events per Apply (~100 KB, limit is 4 MB)
+  static constexpr std::size_t kMaxBacklog = 1 << 18;   // queued + inflight events before giving up
+
+  Replicator(std::string standby_addr, WaitStrategy wait, std::vector<int> cpus);
+  ~Replicator();
+
+  Replicator(const Replicator&)            = delete;
+  Replicator& operator=(const Replicator&) = delete;
+
+  // Stamps ev with the next seq and queues it. Returns the seq.
+  uint64_t publish(mat_eng::ReplicationEvent ev);
+
+  // Block until the standby confirmed seq (true) or timeout expired (false). False at once if
+  // seq was dropped with the backlog.
+  bool wait_acked(uint64_t seq, std::chrono::milliseconds timeout);
+
+private:
+  void run_();
+
+  std::unique_ptr<mat_eng::Replication::Stub> stub_;
+  const WaitStrategy wait_;
+  const std::vector<int> cpus_;
+  const uint64_t epoch_;
+
+  // Written under mu_ (so Blocking waiters can't miss a notify); the atomics are also read
+  // without it by the spinning wait strategies.
+  std::mutex mu_;
+  std::condition_variable cv_;        // queue non-empty / stop
+  std::condition_variable acked_cv_;  // acked_seq_ moved
+  std::deque<mat_eng::ReplicationEvent> queue_;   // published, not picked up by the sender yet
+  std::size_t inflight_ = 0;         // picked up by the sender, not acknowledged yet
+  uint64_t next_seq_  = 1;
+  std::atomic<bool>     queued_{false};       // !queue_.empty()
+  std::atomic<uint64_t> acked_seq_{0};
+  std::atomic<bool>     overflowed_{false};   // backlog dropped; the standby needs a resync
+  std::atomic<bool>     stop_{false};
+
+  std::thread thread_;
+};
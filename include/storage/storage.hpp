@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <vector>
 
 // Row used when recording a fill
 struct FillRow {
@@ -32,8 +33,7 @@ public:
   uint64_t load_next_oid_seq() const;
 
   // Insert a new order in state NEW (status=0) with remaining_quantity=quantity.
-  // price is nullable for MARKET orders (pass std::nullopt).
-  bool insert_new_order(const Order& o);
+  bool insert_new_order(const Order& o, mat_eng::OrderType type = mat_eng::LIMIT);
 
   // Update order status and remaining qty.
   bool update_order_status(const std::string& order_id,
@@ -44,6 +44,10 @@ public:
   // Append a fill row (use a short transaction when you also update the order).
   bool add_fill(const FillRow& f);
 
+  // LIMIT orders still open (NEW / PARTIALLY_FILLED), oldest first, quantity = remaining.
+  // Used to rebuild the in-memory books at startup. Empty on error.
+  std::vector<Order> load_open_limit_orders() const;
+
   // Convenience book snapshots (based on stored orders; real-time book should live in memory).
   std::optional<int64_t> best_bid(const std::string& symbol) const; // side=0
   std::optional<int64_t> best_ask(const std::string& symbol) const; // side=1
@@ -0,0 +1,32 @@
+param(
+  [string]$ServerExe  = ".\build\Release\server.exe",
+  [string]$GatewayExe = ".\build\Release\gateway.exe",
+  [string]$ClientExe  = ".\build\Release\client.exe",
+  [string]$Addr = "localhost:50050"
+)
+
+# Two engine processes, each with its own database, behind one gateway
+$b0 = Start-Process -FilePath $ServerExe -ArgumentList "--addr 127.0.0.1:50051 --db db/engine0.db" -PassThru
+$b1 = Start-Process -FilePath $ServerExe -ArgumentList "--addr 127.0.0.1:50052 --db db/engine1.db" -PassThru
+$gw = Start-Process -FilePath $GatewayExe -ArgumentList "--addr 127.0.0.1:50050 --backend 127.0.0.1:50051 --backend 127.0.0.1:50052 --route AAA=0 --route BBB=1" -PassThru
+Start-Sleep -Milliseconds 1200
+
+function Run-Case($symbol, $expectedBackend) {
+  $out = & $ClientExe $Addr C1 $symbol BUY LIMIT 10050 2 10
+  if ($LASTEXITCODE -ne 0) {
+    Write-Error "Client failed: $out"
+    exit 1
+  }
+  if ($out -notmatch "accepted order_id=$expectedBackend`:") {
+    Write-Error "Unexpected client output: $out"
+    exit 1
+  }
+  Write-Host "[OK] $symbol -> $out"
+}
+
+Run-Case AAA 0
+Run-Case BBB 1
+Run-Case AAA 0
+
+# Stop everything
+Stop-Process -Id $gw.Id, $b0.Id, $b1.Id -Force
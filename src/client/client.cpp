@@ -1,6 +1,7 @@
 #include <grpcpp/grpcpp.h>
 #include "matching_engine.grpc.pb.h"
 #include "matching_engine.pb.h"
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -11,12 +12,67 @@ static void usage(const char* prog) {
     std::cerr <<
       "Usage:\n"
       "  " << prog << " <addr> <client_id> <symbol> <BUY|SELL> <LIMIT|MARKET> <price> <scale> <qty>\n"
+      "  " << prog << " <addr> promote        (turn a standby into the primary)\n"
+      "  " << prog << " <addr> cancel <client_id> <order_id>\n"
       "  Example:\n"
       "  " << prog << " localhost:50051 C1 SYM BUY LIMIT 10050 2 10\n"
-      "  " << prog << " localhost:50051 C2 SYM SELL MARKET 0 0 25\n";
+      "  " << prog << " localhost:50051 C2 SYM SELL MARKET 0 0 25\n"
+      "  " << prog << " unix:/tmp/me_standby.sock promote\n"
+      "  " << prog << " localhost:50051 cancel C1 OID-1\n";
+}
+
+static int cancel(const std::string& addr, const std::string& client_id, const std::string& order_id) {
+    auto channel = grpc::CreateChannel(addr, grpc::InsecureChannelCredentials());
+    auto stub = mat_eng::MatchingEngine::NewStub(channel);
+
+    grpc::ClientContext ctx;
+    ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+    mat_eng::CancelRequest req;
+    req.set_client_id(client_id);
+    req.set_order_id(order_id);
+    mat_eng::CancelResponse resp;
+    grpc::Status status = stub->CancelOrder(&ctx, req, &resp);
+
+    if (!status.ok()) {
+        std::cerr << "[client] RPC failed: " << status.error_code() << " - " << status.error_message() << "\n";
+        return 2;
+    }
+    if (!resp.success()) {
+        std::cerr << "[client] cancel refused: " << resp.error_message() << "\n";
+        return 3;
+    }
+    std::cout << "[client] canceled order_id=" << resp.order_id() << "\n";
+    return 0;
+}
+
+static int promote(const std::string& addr) {
+    auto channel = grpc::CreateChannel(addr, grpc::InsecureChannelCredentials());
+    auto stub = mat_eng::Replication::NewStub(channel);
+
+    grpc::ClientContext ctx;
+    ctx.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(2));
+    mat_eng::PromoteRequest req;
+    mat_eng::PromoteResponse resp;
+    const auto t0 = std::chrono::steady_clock::now();
+    grpc::Status status = stub->Promote(&ctx, req, &resp);
+    const auto dur_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    if (!status.ok()) {
+        std::cerr << "[client] RPC failed: " << status.error_code() << " - " << status.error_message() << "\n";
+        return 2;
+    }
+    if (!resp.success()) {
+        std::cerr << "[client] promote refused: " << resp.error_message() << "\n";
+        return 3;
+    }
+    std::cout << "[client] promoted at seq=" << resp.applied_seq() << " in " << dur_ms << "ms\n";
+    return 0;
 }
 
 int main(int argc, char** argv) {
+    if (argc == 3 && std::string(argv[2]) == "promote") return promote(argv[1]);
+    if (argc == 5 && std::string(argv[2]) == "cancel") return cancel(argv[1], argv[3], argv[4]);
     if (argc < 9) { usage(argv[0]); return 1; }
 
     std::string addr     = argv[1];
@@ -45,6 +101,10 @@ int main(int argc, char** argv) {
     mat_eng::OrderResponse resp;
     grpc::Status status = stub->SubmitOrder(&ctx, req, &resp);
 
+    if (status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED) {
+        std::cerr << "[client] shed by server: " << status.error_message() << "\n";
+        return 4;
+    }
     if (!status.ok()) {
         std::cerr << "[client] RPC failed: " << status.error_code() << " - " << status.error_message() << "\n";
         return 2;
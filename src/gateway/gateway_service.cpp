@@ -0,0 +1,190 @@
+#include "gateway/gateway_service.hpp"
+#include "server/admission_control.hpp"
+
+#include <charconv>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+namespace mat_eng = matching_engine::v1;
+
+// ========================== construction ========================
+GatewayServiceImpl::GatewayServiceImpl(std::vector<std::string> backend_addrs, SymbolRouter router)
+  : router_(std::move(router))
+{
+  if (backend_addrs.size() != router_.backend_count())
+    throw std::invalid_argument("router and backend list disagree on backend count");
+
+  backends_.reserve(backend_addrs.size());
+  for (const auto& addr : backend_addrs) {
+    // InsecureChannelCredentials() is fine for loopback backends. For anything else, switch to TLS
+    auto channel = grpc::CreateChannel(addr, grpc::InsecureChannelCredentials());
+    backends_.push_back(mat_eng::MatchingEngine::NewStub(channel));
+  }
+}
+
+std::string GatewayServiceImpl::qualify_order_id(std::size_t backend, const std::string& order_id) {
+  return std::to_string(backend) + ":" + order_id;
+}
+
+bool GatewayServiceImpl::split_order_id(const std::string& qualified, std::size_t& backend, std::string& order_id) {
+  const auto colon = qualified.find(':');
+  if (colon == 0 || colon == std::string::npos) return false;
+  // Digits only, and it must fit: from_chars reports overflow instead of wrapping
+  std::size_t b = 0;
+  const char* end = qualified.data() + colon;
+  const auto [ptr, ec] = std::from_chars(qualified.data(), end, b);
+  if (ec != std::errc{} || ptr != end) return false;
+  backend  = b;
+  order_id = qualified.substr(colon + 1);
+  return true;
+}
+
+// ========================== unary RPCs ==========================
+
+// RPC: SubmitOrder(OrderRequest) -> OrderResponse, forwarded to the symbol's backend
+grpc::Status GatewayServiceImpl::SubmitOrder(
+    grpc::ServerContext* ctx,
+    const mat_eng::OrderRequest* req,
+    mat_eng::OrderResponse* resp) {
+
+  // Can't route without a symbol; answer like the engine would
+  if (req->symbol().empty()) {
+    resp->set_success(false);
+    resp->set_error_message("symbol is required");
+    return grpc::Status::OK;
+  }
+
+  const std::size_t b = router_.route(req->symbol());
+  auto cctx = grpc::ClientContext::FromServerContext(*ctx);   // propagate deadline + cancellation
+  grpc::Status st = backends_[b]->SubmitOrder(cctx.get(), *req, resp);
+
+  if (st.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED) {
+    // Load shedding is the backend working as intended: pass the back-off hint through, don't log
+    const auto& trailers = cctx->GetServerTrailingMetadata();
+    auto it = trailers.find(kRetryAfterMetadataKey);
+    if (it != trailers.end()) ctx->AddTrailingMetadata(kRetryAfterMetadataKey, std::string(it->second.data(), it->second.size()));
+    return st;
+  }
+  if (!st.ok()) {
+    std::cerr << "[GATEWAY] [SubmitOrder][error] backend=" << b << " symbol=" << req->symbol()
+              << " code=" << st.error_code() << " msg=" << st.error_message() << "\n";
+    return st;
+  }
+  if (!resp->order_id().empty()) resp->set_order_id(qualify_order_id(b, resp->order_id()));
+  return st;
+}
+
+// RPC: CancelOrder(CancelRequest) -> CancelResponse, forwarded to the backend named in the order id
+grpc::Status GatewayServiceImpl::CancelOrder(
+    grpc::ServerContext* ctx,
+    const mat_eng::CancelRequest* req,
+    mat_eng::CancelResponse* resp) {
+
+  resp->set_order_id(req->order_id());
+  std::size_t b = 0;
+  mat_eng::CancelRequest fwd = *req;
+  if (!split_order_id(req->order_id(), b, *fwd.mutable_order_id()) || b >= backends_.size()) {
+    resp->set_success(false);
+    resp->set_error_message("unknown order");
+    return grpc::Status::OK;
+  }
+
+  auto cctx = grpc::ClientContext::FromServerContext(*ctx);
+  grpc::Status st = backends_[b]->CancelOrder(cctx.get(), fwd, resp);
+  if (!st.ok()) {
+    std::cerr << "[GATEWAY] [CancelOrder][error] backend=" << b << " oid=" << req->order_id()
+              << " code=" << st.error_code() << " msg=" << st.error_message() << "\n";
+    return st;
+  }
+  resp->set_order_id(req->order_id());
+  return st;
+}
+
+// RPC: GetOrderBook(OrderBookRequest) -> OrderBookResponse, forwarded to the symbol's backend
+grpc::Status GatewayServiceImpl::GetOrderBook(
+    grpc::ServerContext* ctx,
+    const mat_eng::OrderBookRequest* req,
+    mat_eng::OrderBookResponse* resp) {
+
+  const std::size_t b = router_.route(req->symbol());
+  auto cctx = grpc::ClientContext::FromServerContext(*ctx);
+  grpc::Status st = backends_[b]->GetOrderBook(cctx.get(), *req, resp);
+  if (!st.ok()) return st;
+
+  for (auto& o : *resp->mutable_bids()) o.set_order_id(qualify_order_id(b, o.order_id()));
+  for (auto& o : *resp->mutable_asks()) o.set_order_id(qualify_order_id(b, o.order_id()));
+  return st;
+}
+
+// ========================== streams =============================
+
+// Market data is per symbol, so a single backend owns the whole stream: plain proxy
+grpc::Status GatewayServiceImpl::StreamMarketData(
+    grpc::ServerContext* ctx,
+    const mat_eng::MarketDataRequest* req,
+    grpc::ServerWriter<mat_eng::MarketDataUpdate>* writer) {
+
+  const std::size_t b = router_.route(req->symbol());
+  auto cctx = grpc::ClientContext::FromServerContext(*ctx);
+  auto reader = backends_[b]->StreamMarketData(cctx.get(), *req);
+
+  mat_eng::MarketDataUpdate u;
+  while (reader->Read(&u)) {
+    if (!writer->Write(u)) { cctx->TryCancel(); break; }   // downstream client went away
+  }
+  return reader->Finish();
+}
+
+// A client's orders can live on every backend: subscribe to all of them and merge.
+// Updates from one backend stay in order; there is no ordering across backends.
+// The first backend failure ends the whole stream with that status: the other subscriptions
+// are cancelled, since a merged stream with a silent hole in it is worse than resubscribing.
+grpc::Status GatewayServiceImpl::StreamOrderUpdates(
+    grpc::ServerContext* ctx,
+    const mat_eng::OrderUpdatesRequest* req,
+    grpc::ServerWriter<mat_eng::OrderUpdate>* writer) {
+
+  std::mutex write_mu;                       // ServerWriter::Write is not thread-safe
+  std::mutex status_mu;
+  grpc::Status first_error = grpc::Status::OK;
+
+  std::vector<std::unique_ptr<grpc::ClientContext>> cctxs;
+  cctxs.reserve(backends_.size());
+  for (std::size_t b = 0; b < backends_.size(); ++b)
+    cctxs.push_back(grpc::ClientContext::FromServerContext(*ctx));
+
+  auto cancel_all = [&cctxs] { for (auto& c : cctxs) c->TryCancel(); };
+
+  std::vector<std::thread> readers;
+  readers.reserve(backends_.size());
+  for (std::size_t b = 0; b < backends_.size(); ++b) {
+    readers.emplace_back([&, b] {
+      auto reader = backends_[b]->StreamOrderUpdates(cctxs[b].get(), *req);
+
+      mat_eng::OrderUpdate u;
+      while (reader->Read(&u)) {
+        u.set_order_id(qualify_order_id(b, u.order_id()));
+        std::lock_guard<std::mutex> lk(write_mu);
+        if (!writer->Write(u)) { cancel_all(); break; }
+      }
+
+      grpc::Status st = reader->Finish();
+      if (!st.ok() && st.error_code() != grpc::StatusCode::CANCELLED) {
+        std::cerr << "[GATEWAY] [StreamOrderUpdates][error] backend=" << b
+                  << " code=" << st.error_code() << " msg=" << st.error_message() << "\n";
+        {
+          std::lock_guard<std::mutex> lk(status_mu);
+          if (first_error.ok()) first_error = st;
+        }
+        cancel_all();
+      }
+    });
+  }
+  for (auto& t : readers) t.join();
+
+  if (ctx->IsCancelled()) return grpc::Status::CANCELLED;
+  return first_error;
+}
@@ -0,0 +1,101 @@
+#include "gateway/gateway_service.hpp"
+#include "gateway/symbol_router.hpp"
+
+#include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+static std::atomic<bool> g_stop{false};
+static void on_signal(int) { g_stop.store(true, std::memory_order_relaxed); }
+
+static void usage(const char* prog) {
+  std::cerr <<
+    "Usage:\n"
+    "  " << prog << " [--addr <host:port>] --backend <host:port> [--backend ...] [--route <SYMBOL>=<index> ...]\n"
+    "  Example (two engines, AAPL pinned to the second one, everything else hashed):\n"
+    "  " << prog << " --addr 0.0.0.0:50050 --backend 127.0.0.1:50051 --backend 127.0.0.1:50052 --route AAPL=1\n";
+}
+
+// "SYMBOL=<index>"; false on a missing symbol or an index that isn't a number that fits
+static bool parse_route(const std::string& r, std::pair<std::string, std::size_t>& out) {
+  const auto eq = r.find('=');
+  if (eq == 0 || eq == std::string::npos) return false;
+  const char* end = r.data() + r.size();
+  const auto [ptr, ec] = std::from_chars(r.data() + eq + 1, end, out.second);
+  if (ec != std::errc{} || ptr != end) return false;
+  out.first = r.substr(0, eq);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  std::string addr = "0.0.0.0:50050";
+  std::vector<std::string> backends;
+  std::vector<std::pair<std::string, std::size_t>> routes;
+
+  try {
+    // Parse command line and flags
+    for (int i = 1; i < argc; ++i) {
+      std::string a = argv[i];
+      if (a == "--addr" && i + 1 < argc) addr = argv[++i];
+      else if (a == "--backend" && i + 1 < argc) backends.emplace_back(argv[++i]);
+      else if (a == "--route" && i + 1 < argc) {
+        const std::string r = argv[++i];
+        if (!parse_route(r, routes.emplace_back())) {
+          std::cerr << "[GATEWAY] ERROR: --route expects SYMBOL=<index>, got: " << r << "\n";
+          usage(argv[0]);
+          return 1;
+        }
+      }
+    }
+    if (backends.empty()) { usage(argv[0]); return 1; }
+
+    SymbolRouter router(backends.size());
+    for (const auto& [symbol, b] : routes) router.pin(symbol, b);
+
+    GatewayServiceImpl service(backends, std::move(router));
+
+    grpc::ServerBuilder builder;
+    int selected_port = 0;
+    builder.AddListeningPort(addr, grpc::InsecureServerCredentials(), &selected_port);
+    builder.RegisterService(&service);
+    std::unique_ptr<grpc::Server> server = builder.BuildAndStart();
+
+    if (!server) {
+      std::cerr << "[GATEWAY] ERROR: BuildAndStart() returned null\n";
+      return 1;
+    }
+    if (selected_port == 0) {
+      std::cerr << "[GATEWAY] ERROR: failed to bind " << addr << " (in use or permission issue)\n";
+      return 1;
+    }
+
+    std::cout << "[GATEWAY] listening on " << addr << " ; backends=";
+    for (std::size_t b = 0; b < backends.size(); ++b) std::cout << (b ? "," : "") << b << "=" << backends[b];
+    std::cout << "\n";
+
+    std::signal(SIGINT,  on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    std::thread stopper([&]{
+      while (!g_stop.load(std::memory_order_relaxed)) std::this_thread::sleep_for(50ms);
+      server->Shutdown(std::chrono::system_clock::now() + 2s);
+    });
+
+    server->Wait();
+    stopper.join();
+    return 0;
+
+  } catch (const std::exception& e) {
+    std::cerr << "[GATEWAY] Fatal error: " << e.what() << "\n";
+    return 3;
+  }
+}
@@ -0,0 +1,48 @@
+#include "gateway/symbol_router.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+SymbolRouter::SymbolRouter(std::size_t backend_count, int virtual_nodes)
+  : backend_count_(backend_count)
+{
+  if (backend_count_ == 0) throw std::invalid_argument("gateway needs at least one backend");
+
+  ring_.reserve(backend_count_ * static_cast<std::size_t>(virtual_nodes));
+  for (std::size_t b = 0; b < backend_count_; ++b) {
+    for (int v = 0; v < virtual_nodes; ++v) {
+      ring_.emplace_back(hash("backend-" + std::to_string(b) + "#" + std::to_string(v)), b);
+    }
+  }
+  std::sort(ring_.begin(), ring_.end());
+}
+
+void SymbolRouter::pin(const std::string& symbol, std::size_t backend) {
+  if (backend >= backend_count_)
+    throw std::out_of_range("route " + symbol + "=" + std::to_string(backend) + ": no such backend");
+  static_[symbol] = backend;
+}
+
+std::size_t SymbolRouter::route(const std::string& symbol) const {
+  if (auto it = static_.find(symbol); it != static_.end()) return it->second;
+
+  // First ring point clockwise from the symbol's hash (wrap around at the end)
+  const uint64_t h = hash(symbol);
+  auto it = std::lower_bound(ring_.begin(), ring_.end(), std::make_pair(h, std::size_t{0}));
+  if (it == ring_.end()) it = ring_.begin();
+  return it->second;
+}
+
+uint64_t SymbolRouter::hash(const std::string& s) {
+  uint64_t h = 14695981039346656037ULL;   // FNV-1a offset basis
+  for (unsigned char c : s) {
+    h ^= c;
+    h *= 1099511628211ULL;                // FNV prime
+  }
+  // FNV alone clusters short keys that differ in one char ("SYM1", "SYM2"): finish with
+  // the murmur3 fmix64 avalanche so ring points and symbols spread evenly
+  h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
@@ -0,0 +1,151 @@
+#include "order_entry/client.hpp"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace oe {
+
+[[noreturn]] static void fail_errno(const std::string& what) {
+  throw std::runtime_error("order entry client: " + what + ": " + std::strerror(errno));
+}
+
+Client Client::connect_tcp(const std::string& host, int port) {
+  addrinfo hints{};
+  hints.ai_family   = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* res = nullptr;
+  if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &res) != 0 || !res)
+    throw std::runtime_error("order entry client: cannot resolve " + host);
+
+  int fd = -1;
+  for (addrinfo* ai = res; ai; ai = ai->ai_next) {
+    fd = ::socket(ai->ai_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) continue;
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+    ::close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(res);
+  if (fd < 0) fail_errno("connect " + host + ":" + std::to_string(port));
+
+  int one = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+  return Client(fd);
+}
+
+Client Client::connect_unix(const std::string& path) {
+  sockaddr_un sa{};
+  sa.sun_family = AF_UNIX;
+  if (path.size() >= sizeof sa.sun_path) throw std::runtime_error("order entry client: unix socket path too long: " + path);
+  std::memcpy(sa.sun_path, path.c_str(), path.size() + 1);
+
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) fail_errno("socket");
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&sa), sizeof sa) != 0) {
+    const int err = errno;
+    ::close(fd);
+    errno = err;
+    fail_errno("connect " + path);
+  }
+  return Client(fd);
+}
+
+Client::~Client() {
+  if (fd_ >= 0) ::close(fd_);
+}
+
+Client::Client(Client&& other) noexcept
+  : fd_(std::exchange(other.fd_, -1)),
+    out_(std::move(other.out_)),
+    in_(std::move(other.in_)),
+    in_off_(std::exchange(other.in_off_, 0)) {}
+
+Client& Client::operator=(Client&& other) noexcept {
+  if (this != &other) {
+    if (fd_ >= 0) ::close(fd_);
+    fd_     = std::exchange(other.fd_, -1);
+    out_    = std::move(other.out_);
+    in_     = std::move(other.in_);
+    in_off_ = std::exchange(other.in_off_, 0);
+  }
+  return *this;
+}
+
+template <class Msg>
+void Client::queue(const Msg& m) {
+  const std::size_t at = out_.size();
+  out_.resize(at + kMaxMessageSize);
+  out_.resize(at + encode(m, out_.data() + at));
+}
+
+// The wire fields are fixed width; refuse to send a silently truncated id
+static void check_width(const char* field, const std::string& s, std::size_t width) {
+  if (s.size() > width)
+    throw std::invalid_argument(std::string("order entry client: ") + field + " longer than " +
+                                std::to_string(width) + " bytes: " + s);
+}
+
+void Client::send(const NewOrder& m) {
+  check_width("client_id", m.client_id, kClientIdLen);
+  check_width("symbol", m.symbol, kSymbolLen);
+  queue(m);
+}
+
+void Client::send(const CancelOrder& m) {
+  check_width("client_id", m.client_id, kClientIdLen);
+  queue(m);
+}
+
+void Client::flush() {
+  std::size_t off = 0;
+  while (off < out_.size()) {
+    const ssize_t n = ::send(fd_, out_.data() + off, out_.size() - off, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) fail_errno("send");
+    off += static_cast<std::size_t>(n);
+  }
+  out_.clear();
+}
+
+Client::Message Client::read() {
+  flush();
+  for (;;) {
+    MsgType type{};
+    std::size_t size = 0;
+    const Frame f = peek_frame(in_.data() + in_off_, in_.size() - in_off_, type, size);
+    if (f == Frame::Malformed) throw std::runtime_error("order entry client: malformed message from server");
+    if (f == Frame::Ready) {
+      const uint8_t* p = in_.data() + in_off_;
+      in_off_ += size;
+      switch (type) {
+        case MsgType::Ack:    return decode_ack(p);
+        case MsgType::Reject: return decode_reject(p);
+        case MsgType::Fill:   return decode_fill(p);
+        default: throw std::runtime_error("order entry client: unexpected message type from server");
+      }
+    }
+
+    // Need more bytes: compact, then read whatever is available
+    in_.erase(in_.begin(), in_.begin() + static_cast<std::ptrdiff_t>(in_off_));
+    in_off_ = 0;
+    const std::size_t used = in_.size();
+    in_.resize(used + 4096);
+    const ssize_t n = ::recv(fd_, in_.data() + used, 4096, 0);
+    const int err = errno;
+    in_.resize(used + static_cast<std::size_t>(n > 0 ? n : 0));
+    if (n == 0) throw std::runtime_error("order entry client: server closed the connection");
+    if (n < 0 && err == EINTR) continue;
+    if (n < 0) { errno = err; fail_errno("recv"); }
+  }
+}
+
+} // namespace oe
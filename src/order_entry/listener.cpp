@@ -0,0 +1,421 @@
+#include "order_entry/listener.hpp"
+
+#include "order_entry/protocol.hpp"
+#include "runtime/thread_affinity.hpp"
+#include "runtime/wait_strategy.hpp"
+#include "server/matching_engine_service.hpp"
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace mat_eng = matching_engine::v1;
+
+// -------------------- helpers --------------------
+
+static constexpr std::size_t kReadChunk    = 64 * 1024;
+static constexpr std::size_t kInHighWater  = 4 * kReadChunk;   // buffered request bytes per connection
+static constexpr std::size_t kOutHighWater = 64 * 1024;        // unsent reply bytes before we stop parsing
+static constexpr int         kMaxEvents    = 64;
+
+[[noreturn]] static void fail_errno(const std::string& what, int fd = -1) {
+  const int err = errno;
+  if (fd >= 0) ::close(fd);
+  throw std::runtime_error("order entry: " + what + ": " + std::strerror(err));
+}
+
+static int listen_tcp(const std::string& addr, int& port_out) {
+  const auto colon = addr.rfind(':');
+  if (colon == std::string::npos) throw std::runtime_error("order entry: expected host:port, got " + addr);
+  const std::string host = addr.substr(0, colon);
+  const std::string port = addr.substr(colon + 1);
+
+  addrinfo hints{};
+  hints.ai_family   = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags    = AI_PASSIVE;
+  addrinfo* res = nullptr;
+  if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &res) != 0 || !res)
+    throw std::runtime_error("order entry: cannot resolve " + addr);
+
+  const int fd = ::socket(res->ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) { freeaddrinfo(res); fail_errno("socket " + addr); }
+  int one = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof one);
+  const bool bound = ::bind(fd, res->ai_addr, res->ai_addrlen) == 0;
+  freeaddrinfo(res);
+  if (!bound || ::listen(fd, SOMAXCONN) != 0) fail_errno("bind " + addr, fd);
+
+  sockaddr_storage ss{};
+  socklen_t len = sizeof ss;
+  ::getsockname(fd, reinterpret_cast<sockaddr*>(&ss), &len);
+  port_out = (ss.ss_family == AF_INET6) ? ntohs(reinterpret_cast<sockaddr_in6*>(&ss)->sin6_port)
+                                        : ntohs(reinterpret_cast<sockaddr_in*>(&ss)->sin_port);
+  return fd;
+}
+
+static int listen_unix(const std::string& path) {
+  sockaddr_un sa{};
+  sa.sun_family = AF_UNIX;
+  if (path.size() >= sizeof sa.sun_path) throw std::runtime_error("order entry: unix socket path too long: " + path);
+  std::memcpy(sa.sun_path, path.c_str(), path.size() + 1);
+  ::unlink(path.c_str());   // stale socket from a previous run
+
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) fail_errno("socket " + path);
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&sa), sizeof sa) != 0 || ::listen(fd, SOMAXCONN) != 0)
+    fail_errno("bind " + path, fd);
+  return fd;
+}
+
+// Failed requests -> wire reject reason. UNAVAILABLE from a primary can only mean the
+// standby missed the --repl-sync deadline; from a standby it means "not accepting orders".
+static oe::Reject reject_for(uint64_t client_seq, const grpc::Status& st, bool primary, uint32_t retry_after_ms = 0) {
+  oe::Reject r;
+  r.client_seq     = client_seq;
+  r.retry_after_ms = retry_after_ms;
+  r.text           = st.error_message();
+  switch (st.error_code()) {
+    case grpc::StatusCode::UNAVAILABLE:
+      r.reason = primary ? oe::RejectReason::NotReplicated : oe::RejectReason::NotPrimary;
+      break;
+    case grpc::StatusCode::RESOURCE_EXHAUSTED: r.reason = oe::RejectReason::Throttled;  break;
+    default:                                   r.reason = oe::RejectReason::Internal;   break;
+  }
+  return r;
+}
+
+// Failed cancels -> wire reject reason (no separate code for another client's order)
+static oe::RejectReason cancel_reject_reason(CancelOutcome outcome) {
+  switch (outcome) {
+    case CancelOutcome::StorageFailed: return oe::RejectReason::Internal;
+    case CancelOutcome::Canceled:
+    case CancelOutcome::UnknownOrder:
+    case CancelOutcome::NotOwner:      return oe::RejectReason::UnknownOrder;
+  }
+  return oe::RejectReason::UnknownOrder;
+}
+
+// ============================= Impl =============================
+struct OrderEntryListener::Impl {
+  struct Conn {
+    int fd = -1;
+    std::vector<uint8_t> in;        // received, not yet parsed
+    std::vector<uint8_t> out;       // encoded replies not yet sent
+    std::size_t out_off  = 0;
+    bool        want_out = false;   // EPOLLOUT registered instead of EPOLLIN: the peer isn't reading
+    bool        stalled  = false;   // stopped parsing at kOutHighWater with frames left in `in`
+  };
+
+  Impl(MatchingEngineServiceImpl& e, OrderEntryConfig c, WaitStrategy w, std::vector<int> cpu_list)
+    : engine(e), cfg(std::move(c)), wait(w), cpus(std::move(cpu_list)) {}
+
+  MatchingEngineServiceImpl& engine;
+  OrderEntryConfig cfg;
+  WaitStrategy wait;
+  std::vector<int> cpus;
+
+  int ep       = -1;
+  int stop_fd  = -1;   // eventfd, readable once stop() is called
+  int tcp_fd   = -1;
+  int unix_fd  = -1;
+  int tcp_port = 0;
+
+  std::unordered_map<int, Conn> conns;   // fd -> connection (loop thread only)
+  std::vector<int> dirty;                // connections that queued replies this iteration
+  std::vector<int> resume, resuming;     // stalled connections whose replies drained
+  std::array<uint8_t, kReadChunk> scratch;
+  std::thread thread;
+
+  bool watch(int fd, uint32_t events, int op = EPOLL_CTL_ADD) {
+    epoll_event ev{};
+    ev.events  = events;
+    ev.data.fd = fd;
+    return ::epoll_ctl(ep, op, fd, &ev) == 0;
+  }
+
+  template <class Msg>
+  void queue(Conn& c, const Msg& m) {
+    const std::size_t at = c.out.size();
+    if (at == 0) dirty.push_back(c.fd);
+    c.out.resize(at + oe::kMaxMessageSize);
+    c.out.resize(at + oe::encode(m, c.out.data() + at));
+  }
+
+  void on_new_order(Conn& c, const oe::NewOrder& m) {
+    if (m.side != mat_eng::BUY && m.side != mat_eng::SELL) {
+      queue(c, oe::Reject{m.client_seq, oe::RejectReason::Invalid, 0, "side must be BUY or SELL"});
+      return;
+    }
+    if (!mat_eng::OrderType_IsValid(m.order_type)) {
+      queue(c, oe::Reject{m.client_seq, oe::RejectReason::Invalid, 0, "bad order type"});
+      return;
+    }
+    mat_eng::OrderRequest req;
+    req.set_client_id(m.client_id);
+    req.set_symbol(m.symbol);
+    req.set_side(static_cast<mat_eng::Side>(m.side));
+    req.set_order_type(static_cast<mat_eng::OrderType>(m.order_type));
+    req.set_price(m.price);
+    req.set_scale(m.scale);
+    req.set_quantity(m.quantity);
+
+    mat_eng::OrderResponse resp;
+    uint32_t retry_after_ms = 0;
+    const grpc::Status st = engine.SubmitOrderDirect(req, &resp, &retry_after_ms);
+    if (!st.ok()) {
+      queue(c, reject_for(m.client_seq, st, engine.is_primary(), retry_after_ms));
+    } else if (resp.success()) {
+      queue(c, oe::Ack{m.client_seq, oe::wire_order_id(resp.order_id()), oe::MsgType::NewOrder});
+    } else {
+      // Validation rejects happen before an id is assigned; anything later is on our side
+      const auto reason = resp.order_id().empty() ? oe::RejectReason::Invalid : oe::RejectReason::Internal;
+      queue(c, oe::Reject{m.client_seq, reason, 0, resp.error_message()});
+    }
+  }
+
+  void on_cancel(Conn& c, const oe::CancelOrder& m) {
+    mat_eng::CancelRequest req;
+    req.set_client_id(m.client_id);
+    req.set_order_id(oe::engine_order_id(m.order_id));
+
+    mat_eng::CancelResponse resp;
+    CancelOutcome outcome = CancelOutcome::Canceled;
+    const grpc::Status st = engine.CancelOrderDirect(req, &resp, &outcome);
+    if (!st.ok()) {
+      queue(c, reject_for(m.client_seq, st, engine.is_primary()));
+    } else if (outcome == CancelOutcome::Canceled) {
+      queue(c, oe::Ack{m.client_seq, m.order_id, oe::MsgType::CancelOrder});
+    } else {
+      queue(c, oe::Reject{m.client_seq, cancel_reject_reason(outcome), 0, resp.error_message()});
+    }
+  }
+
+  // Drain the socket (up to kInHighWater), then handle the frames. False = close the connection.
+  bool on_readable(Conn& c) {
+    bool eof = false;
+    while (c.in.size() < kInHighWater) {
+      const ssize_t n = ::recv(c.fd, scratch.data(), scratch.size(), 0);
+      if (n > 0) {
+        c.in.insert(c.in.end(), scratch.data(), scratch.data() + n);
+        if (static_cast<std::size_t>(n) < scratch.size()) break;   // short read: nothing left
+        continue;
+      }
+      if (n == 0) { eof = true; break; }                           // peer closed (handle what it sent)
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      return false;
+    }
+    return handle_frames(c, /*all=*/eof) && !eof;
+  }
+
+  // Handle complete frames from c.in. Unless `all`, stop once kOutHighWater reply bytes are
+  // waiting: the rest stays buffered until flush() drains them (backpressure instead of growing
+  // c.out without bound for a client that doesn't read). False = close the connection.
+  bool handle_frames(Conn& c, bool all = false) {
+    std::size_t off = 0;
+    c.stalled = false;
+    for (;;) {
+      if (!all && c.out.size() - c.out_off >= kOutHighWater) {
+        c.stalled = true;
+        break;
+      }
+      oe::MsgType type{};
+      std::size_t size = 0;
+      const oe::Frame f = oe::peek_frame(c.in.data() + off, c.in.size() - off, type, size);
+      if (f == oe::Frame::Incomplete) break;
+
+      const uint8_t* p = c.in.data() + off;
+      if (f != oe::Frame::Ready || (type != oe::MsgType::NewOrder && type != oe::MsgType::CancelOrder)) {
+        std::cerr << "[OE] malformed frame from fd=" << c.fd << ", closing\n";
+        return false;
+      }
+      // Nothing a client sends may take the loop thread down (gRPC would catch this for its handlers)
+      const uint64_t client_seq = oe::detail::get<uint64_t>(p + oe::kHeaderSize);
+      try {
+        if (type == oe::MsgType::NewOrder) on_new_order(c, oe::decode_new_order(p));
+        else                               on_cancel(c, oe::decode_cancel_order(p));
+      } catch (const std::exception& e) {
+        std::cerr << "[OE] request failed fd=" << c.fd << " seq=" << client_seq << ": " << e.what() << "\n";
+        queue(c, oe::Reject{client_seq, oe::RejectReason::Internal, 0, "internal error"});
+      }
+      off += size;
+    }
+    c.in.erase(c.in.begin(), c.in.begin() + static_cast<std::ptrdiff_t>(off));
+    return true;
+  }
+
+  // Send queued replies. If the peer's window is full, watch EPOLLOUT only: we stop reading
+  // its requests until it reads our replies. False = close the connection.
+  bool flush(Conn& c) {
+    while (c.out_off < c.out.size()) {
+      const ssize_t n = ::send(c.fd, c.out.data() + c.out_off, c.out.size() - c.out_off, MSG_NOSIGNAL);
+      if (n > 0) { c.out_off += static_cast<std::size_t>(n); continue; }
+      if (n < 0 && errno == EINTR) continue;
+      if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        if (!c.want_out && !watch(c.fd, EPOLLOUT, EPOLL_CTL_MOD)) return false;
+        c.want_out = true;
+        return true;
+      }
+      return false;
+    }
+    c.out.clear();
+    c.out_off = 0;
+    if (c.stalled) resume.push_back(c.fd);   // its buffered frames won't raise another EPOLLIN
+    if (c.want_out) {
+      c.want_out = false;
+      return watch(c.fd, EPOLLIN, EPOLL_CTL_MOD);
+    }
+    return true;
+  }
+
+  void accept_all(int lfd) {
+    for (;;) {
+      const int fd = ::accept4(lfd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) {
+        if (errno == EINTR) continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK) std::cerr << "[OE] accept failed: " << std::strerror(errno) << "\n";
+        return;
+      }
+      if (lfd == tcp_fd) {
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);   // replies are tiny; don't batch them in the kernel
+      }
+      if (!watch(fd, EPOLLIN)) { ::close(fd); continue; }
+
+      Conn& c = conns[fd];
+      c = Conn{};
+      c.fd = fd;
+      c.in.reserve(kReadChunk);
+    }
+  }
+
+  void close_conn(int fd) {
+    ::epoll_ctl(ep, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    conns.erase(fd);
+  }
+
+  void run() {
+    pin_current_thread_once(cpus);   // SubmitOrder pins "once" too; this makes it a no-op here
+
+    std::array<epoll_event, kMaxEvents> evs;
+    const int timeout = (wait == WaitStrategy::Blocking) ? -1 : 0;
+    for (;;) {
+      const int n = ::epoll_wait(ep, evs.data(), kMaxEvents, resume.empty() ? timeout : 0);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        std::cerr << "[OE] epoll_wait failed: " << std::strerror(errno) << "\n";
+        return;
+      }
+      if (n == 0 && resume.empty()) {
+        if (wait == WaitStrategy::SpinYield) std::this_thread::yield();
+        else                                 ME_CPU_RELAX();
+        continue;
+      }
+
+      for (int i = 0; i < n; ++i) {
+        const int fd = evs[i].data.fd;
+        if (fd == stop_fd) return;
+        if (fd == tcp_fd || fd == unix_fd) { accept_all(fd); continue; }
+
+        auto it = conns.find(fd);
+        if (it == conns.end()) continue;
+        Conn& c = it->second;
+        bool keep = true;
+        if (evs[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) keep = on_readable(c);
+        if (keep && (evs[i].events & EPOLLOUT))              keep = flush(c);
+        if (!keep) {
+          flush(c);   // best effort: replies to frames handled before the close
+          close_conn(fd);
+        }
+      }
+
+      // Pick up where stalled connections stopped, now that their replies went out
+      resuming.swap(resume);
+      for (int fd : resuming) {
+        auto it = conns.find(fd);
+        if (it == conns.end() || !it->second.stalled || it->second.want_out) continue;
+        if (!handle_frames(it->second)) {
+          flush(it->second);
+          close_conn(fd);
+        }
+      }
+      resuming.clear();
+
+      // One send per connection for everything this iteration produced
+      for (int fd : dirty) {
+        auto it = conns.find(fd);
+        if (it != conns.end() && !flush(it->second)) close_conn(fd);
+      }
+      dirty.clear();
+    }
+  }
+
+  void close_all() {
+    for (auto& [fd, c] : conns) ::close(fd);
+    conns.clear();
+    for (int* fd : {&tcp_fd, &unix_fd, &stop_fd, &ep}) {
+      if (*fd >= 0) ::close(*fd);
+      *fd = -1;
+    }
+    if (!cfg.unix_path.empty()) ::unlink(cfg.unix_path.c_str());
+  }
+};
+
+// ========================== API surface =========================
+OrderEntryListener::OrderEntryListener(MatchingEngineServiceImpl& engine,
+                                       OrderEntryConfig cfg,
+                                       WaitStrategy wait,
+                                       std::vector<int> cpus)
+  : d_(std::make_unique<Impl>(engine, std::move(cfg), wait, std::move(cpus))) {}
+
+OrderEntryListener::~OrderEntryListener() { stop(); }
+
+void OrderEntryListener::start() {
+  if (d_->thread.joinable()) return;
+  try {
+    d_->ep = ::epoll_create1(EPOLL_CLOEXEC);
+    if (d_->ep < 0) fail_errno("epoll_create1");
+    d_->stop_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (d_->stop_fd < 0) fail_errno("eventfd");
+    if (!d_->watch(d_->stop_fd, EPOLLIN)) fail_errno("epoll_ctl");
+
+    if (!d_->cfg.tcp_addr.empty()) {
+      d_->tcp_fd = listen_tcp(d_->cfg.tcp_addr, d_->tcp_port);
+      if (!d_->watch(d_->tcp_fd, EPOLLIN)) fail_errno("epoll_ctl");
+    }
+    if (!d_->cfg.unix_path.empty()) {
+      d_->unix_fd = listen_unix(d_->cfg.unix_path);
+      if (!d_->watch(d_->unix_fd, EPOLLIN)) fail_errno("epoll_ctl");
+    }
+  } catch (...) {
+    d_->close_all();
+    throw;
+  }
+  d_->thread = std::thread([this] { d_->run(); });
+}
+
+void OrderEntryListener::stop() {
+  if (!d_->thread.joinable()) return;
+  const uint64_t one = 1;
+  [[maybe_unused]] const ssize_t w = ::write(d_->stop_fd, &one, sizeof one);
+  d_->thread.join();
+  d_->close_all();
+}
+
+int OrderEntryListener::tcp_port() const { return d_->tcp_port; }
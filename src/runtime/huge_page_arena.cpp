@@ -0,0 +1,107 @@
+#include "runtime/huge_page_arena.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+// -------------------- platform helpers --------------------
+
+static std::size_t normal_page_size() {
+#ifdef _WIN32
+  SYSTEM_INFO si;
+  GetSystemInfo(&si);
+  return si.dwPageSize;
+#else
+  return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+static std::size_t round_up(std::size_t n, std::size_t align) {
+  return (n + align - 1) / align * align;
+}
+
+// Try huge pages first (if asked), then normal pages. Sets `huge` to what we actually got.
+static void* map_region(std::size_t& bytes, bool want_huge, bool& huge) {
+  huge = false;
+#ifdef _WIN32
+  if (want_huge) {
+    const SIZE_T large = GetLargePageMinimum();
+    if (large != 0) {
+      const std::size_t len = round_up(bytes, large);
+      void* p = VirtualAlloc(nullptr, len, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+      if (p) { bytes = len; huge = true; return p; }
+    }
+    std::cerr << "[runtime] large pages unavailable (err=" << GetLastError() << "), using normal pages\n";
+  }
+  bytes = round_up(bytes, normal_page_size());
+  return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+  #ifdef MAP_HUGETLB
+  if (want_huge) {
+    constexpr std::size_t k2MiB = std::size_t(2) << 20;
+    const std::size_t len = round_up(bytes, k2MiB);
+    void* p = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) { bytes = len; huge = true; return p; }
+    std::cerr << "[runtime] MAP_HUGETLB failed (no reserved huge pages?), using normal pages\n";
+  }
+  #endif
+  bytes = round_up(bytes, normal_page_size());
+  void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) return nullptr;
+  #ifdef MADV_HUGEPAGE
+  if (want_huge) madvise(p, bytes, MADV_HUGEPAGE); // transparent huge pages, best effort
+  #endif
+  return p;
+#endif
+}
+
+static void unmap_region(void* p, std::size_t bytes) {
+#ifdef _WIN32
+  (void)bytes;
+  VirtualFree(p, 0, MEM_RELEASE);
+#else
+  munmap(p, bytes);
+#endif
+}
+
+// -------------------- HugePageArena --------------------
+
+HugePageArena::HugePageArena(std::size_t bytes, bool huge_pages, bool prefault) {
+  if (bytes != 0) {
+    size_ = bytes;
+    base_ = map_region(size_, huge_pages, huge_);
+    if (!base_) throw std::bad_alloc();
+
+    if (prefault) {
+      // Write (not read) so the kernel backs every page now instead of mapping the zero page.
+      const std::size_t step = normal_page_size();
+      auto* p = static_cast<volatile unsigned char*>(base_);
+      for (std::size_t off = 0; off < size_; off += step) p[off] = 0;
+    }
+
+    std::cout << "[runtime] engine pool " << (size_ >> 20) << " MiB"
+              << " huge_pages=" << (huge_ ? "yes" : "no")
+              << " prefault="   << (prefault ? "yes" : "no") << "\n";
+
+    region_ = std::make_unique<std::pmr::monotonic_buffer_resource>(
+        base_, size_, std::pmr::new_delete_resource());
+  }
+
+  pool_ = std::make_unique<std::pmr::unsynchronized_pool_resource>(
+      region_ ? static_cast<std::pmr::memory_resource*>(region_.get())
+              : std::pmr::new_delete_resource());
+}
+
+HugePageArena::~HugePageArena() {
+  pool_.reset();     // releases back into region_ (or the heap)
+  region_.reset();
+  if (base_) unmap_region(base_, size_);
+}
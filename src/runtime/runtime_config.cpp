@@ -0,0 +1,111 @@
+#include "runtime/runtime_config.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+// -------------------- helpers --------------------
+
+static std::string trim(const std::string& s) {
+  const auto b = s.find_first_not_of(" \t\r\n");
+  if (b == std::string::npos) return {};
+  const auto e = s.find_last_not_of(" \t\r\n");
+  return s.substr(b, e - b + 1);
+}
+
+static std::vector<int> parse_cpu_list(const std::string& v) {
+  std::vector<int> cpus;
+  std::stringstream ss(v);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    item = trim(item);
+    if (item.empty()) continue;
+    const int cpu = std::stoi(item);
+    if (cpu < 0) throw std::invalid_argument("negative cpu id: " + item);
+    cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+static bool parse_bool(const std::string& v) {
+  if (v == "1" || v == "true"  || v == "on"  || v == "yes") return true;
+  if (v == "0" || v == "false" || v == "off" || v == "no")  return false;
+  throw std::invalid_argument("expected a boolean, got: " + v);
+}
+
+static double parse_non_negative(const std::string& key, const std::string& v) {
+  const double d = std::stod(v);
+  if (!(d >= 0.0)) throw std::invalid_argument(key + " must be >= 0");
+  return d;
+}
+
+WaitStrategy parse_wait_strategy(const std::string& s) {
+  if (s == "blocking")   return WaitStrategy::Blocking;
+  if (s == "spin_yield") return WaitStrategy::SpinYield;
+  if (s == "busy_spin")  return WaitStrategy::BusySpin;
+  throw std::invalid_argument("unknown wait strategy: " + s);
+}
+
+const char* to_string(WaitStrategy w) {
+  switch (w) {
+    case WaitStrategy::Blocking:  return "blocking";
+    case WaitStrategy::SpinYield: return "spin_yield";
+    case WaitStrategy::BusySpin:  return "busy_spin";
+  }
+  return "?";
+}
+
+BookLayout parse_book_layout(const std::string& s) {
+  if (s == "map")         return BookLayout::Map;
+  if (s == "tick_ladder") return BookLayout::TickLadder;
+  throw std::invalid_argument("unknown book layout: " + s);
+}
+
+// -------------------- RuntimeConfig --------------------
+
+void RuntimeConfig::set(const std::string& raw_key, const std::string& raw_value) {
+  const std::string key   = trim(raw_key);
+  const std::string value = trim(raw_value);
+
+  if      (key == "cpu.io")            io_cpus          = parse_cpu_list(value);
+  else if (key == "cpu.engine")        engine_cpus      = parse_cpu_list(value);
+  else if (key == "cpu.persistence")   persistence_cpus = parse_cpu_list(value);
+  else if (key == "wait.default")      default_wait     = parse_wait_strategy(value);
+  else if (key.rfind("wait.", 0) == 0) queue_wait[key.substr(5)] = parse_wait_strategy(value);
+  else if (key == "memory.huge_pages") huge_pages       = parse_bool(value);
+  else if (key == "memory.pool_mb")    pool_bytes       = static_cast<std::size_t>(std::stoull(value)) << 20;
+  else if (key == "memory.prefault")   prefault         = parse_bool(value);
+  else if (key == "book.layout")       default_layout   = parse_book_layout(value);
+  else if (key.rfind("book.layout.", 0) == 0) symbol_layout[key.substr(12)] = parse_book_layout(value);
+  else if (key == "book.ladder_ticks") {
+    ladder_ticks = static_cast<std::size_t>(std::stoull(value));
+    if (ladder_ticks == 0) throw std::invalid_argument("book.ladder_ticks must be > 0");
+  }
+  else if (key == "admission.shards") {
+    admission_shards = static_cast<std::size_t>(std::stoull(value));
+    if (admission_shards == 0) throw std::invalid_argument("admission.shards must be > 0");
+  }
+  else if (key == "admission.max_inflight") admission_max_inflight = static_cast<std::size_t>(std::stoull(value));
+  else if (key == "admission.client_rate")  admission_client_rate  = parse_non_negative(key, value);
+  else if (key == "admission.client_burst") admission_client_burst = parse_non_negative(key, value);
+  else throw std::invalid_argument("unknown runtime key: " + key);
+}
+
+void RuntimeConfig::load_file(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) throw std::runtime_error("cannot open runtime config: " + path);
+
+  std::string line;
+  int lineno = 0;
+  while (std::getline(in, line)) {
+    ++lineno;
+    if (auto hash = line.find('#'); hash != std::string::npos) line.erase(hash);
+    line = trim(line);
+    if (line.empty()) continue;
+
+    const auto eq = line.find('=');
+    if (eq == std::string::npos)
+      throw std::invalid_argument(path + ":" + std::to_string(lineno) + ": expected key=value");
+    set(line.substr(0, eq), line.substr(eq + 1));
+  }
+}
@@ -0,0 +1,48 @@
+#include "runtime/thread_affinity.hpp"
+
+#include <iostream>
+
+#ifdef _WIN32
+  #include <windows.h>
+#elif defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+bool pin_current_thread(const std::vector<int>& cpus) {
+  if (cpus.empty()) return false;
+
+#ifdef _WIN32
+  DWORD_PTR mask = 0;
+  for (int c : cpus) {
+    if (c < static_cast<int>(sizeof(DWORD_PTR) * 8)) mask |= (DWORD_PTR(1) << c);
+  }
+  if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+    std::cerr << "[runtime] SetThreadAffinityMask failed err=" << GetLastError() << "\n";
+    return false;
+  }
+  return true;
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int c : cpus) {
+    if (c < CPU_SETSIZE) CPU_SET(c, &set);
+  }
+  const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  if (rc != 0) {
+    std::cerr << "[runtime] pthread_setaffinity_np failed rc=" << rc << "\n";
+    return false;
+  }
+  return true;
+#else
+  std::cerr << "[runtime] thread pinning not supported on this platform\n";
+  return false;
+#endif
+}
+
+void pin_current_thread_once(const std::vector<int>& cpus) {
+  thread_local bool pinned = false;
+  if (pinned || cpus.empty()) return;
+  pinned = true;               // don't retry on failure, it would only spam the log
+  pin_current_thread(cpus);
+}
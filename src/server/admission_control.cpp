@@ -0,0 +1,137 @@
+#include "server/admission_control.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+static constexpr std::size_t kSweepAbove   = 1024;   // per stripe: drop idle (full) buckets past this
+static constexpr int         kSweepPerCall = 2;      // buckets looked at per take_token; > 1 insert per call
+
+static uint32_t to_retry_ms(double seconds) {
+  const double ms = std::ceil(seconds * 1000.0);
+  return static_cast<uint32_t>(std::clamp(ms, 1.0, 60'000.0));
+}
+
+// -------------------- Ticket --------------------
+
+AdmissionController::Ticket& AdmissionController::Ticket::operator=(Ticket&& o) noexcept {
+  if (this != &o) {
+    release();
+    owner_          = std::exchange(o.owner_, nullptr);
+    shard_          = o.shard_;
+    t0_             = o.t0_;
+    verdict_        = o.verdict_;
+    retry_after_ms_ = o.retry_after_ms_;
+  }
+  return *this;
+}
+
+void AdmissionController::Ticket::release() {
+  if (owner_) std::exchange(owner_, nullptr)->release(shard_, t0_);
+}
+
+// -------------------- AdmissionController --------------------
+
+AdmissionController::AdmissionController(const RuntimeConfig& rt)
+  : shard_count_(std::max<std::size_t>(rt.admission_shards, 1)),
+    max_inflight_(static_cast<uint32_t>(rt.admission_max_inflight)),
+    rate_(rt.admission_client_rate),
+    burst_(rt.admission_client_burst > 0 ? rt.admission_client_burst : std::max(rt.admission_client_rate, 1.0)),
+    shards_(std::make_unique<Shard[]>(shard_count_)),
+    stripes_(std::make_unique<Stripe[]>(kStripes)) {}
+
+AdmissionController::Ticket AdmissionController::admit(const std::string& client_id,
+                                                       const std::string& symbol,
+                                                       Clock::time_point now) {
+  Ticket t;
+  const std::size_t s = shard_of(symbol);
+  Shard& shard = shards_[s];
+
+  // Shard capacity first: a refused order must not burn one of the client's tokens
+  const uint32_t before = shard.inflight.fetch_add(1, std::memory_order_acq_rel);
+  if (max_inflight_ != 0 && before >= max_inflight_) {
+    shard.inflight.fetch_sub(1, std::memory_order_acq_rel);
+    shed_full_.fetch_add(1, std::memory_order_relaxed);
+    const double hold_s = static_cast<double>(shard.hold_ns.load(std::memory_order_relaxed)) * 1e-9;
+    t.verdict_        = Verdict::ShardFull;
+    t.retry_after_ms_ = to_retry_ms(hold_s / max_inflight_);
+    return t;
+  }
+
+  if (rate_ > 0 && !take_token(client_id, now, t.retry_after_ms_)) {
+    shard.inflight.fetch_sub(1, std::memory_order_acq_rel);
+    shed_rate_.fetch_add(1, std::memory_order_relaxed);
+    t.verdict_ = Verdict::RateLimited;
+    return t;
+  }
+
+  admitted_.fetch_add(1, std::memory_order_relaxed);
+  t.owner_ = this;
+  t.shard_ = s;
+  t.t0_    = now;
+  return t;
+}
+
+bool AdmissionController::take_token(const std::string& client_id, Clock::time_point now, uint32_t& retry_after_ms) {
+  Stripe& stripe = stripes_[std::hash<std::string>{}(client_id) % kStripes];
+  std::lock_guard<std::mutex> lk(stripe.mu);
+
+  sweep_some(stripe, now);
+  const std::size_t bucket_count = stripe.buckets.bucket_count();
+  auto [it, fresh] = stripe.buckets.try_emplace(client_id, Bucket{burst_, now});
+  if (stripe.buckets.bucket_count() != bucket_count) stripe.sweeping = false;   // rehash: cursor is gone
+  Bucket& b = it->second;
+  if (!fresh && now > b.last) {
+    b.tokens = std::min(burst_, b.tokens + std::chrono::duration<double>(now - b.last).count() * rate_);
+    b.last   = now;
+  }
+  if (b.tokens >= 1.0) {
+    b.tokens -= 1.0;
+    return true;
+  }
+  retry_after_ms = to_retry_ms((1.0 - b.tokens) / rate_);
+  return false;
+}
+
+// Incremental sweep (stripe.mu held): a bucket that has refilled completely carries no state
+// worth keeping. Looking at a few entries per call, more than the one a call can insert,
+// keeps the map bounded without ever walking all of it under the lock.
+void AdmissionController::sweep_some(Stripe& stripe, Clock::time_point now) {
+  auto& buckets = stripe.buckets;
+  if (buckets.size() <= kSweepAbove) return;
+  for (int n = 0; n < kSweepPerCall; ++n) {
+    if (!stripe.sweeping) {   // start a new pass
+      stripe.sweep_at = buckets.begin();
+      stripe.sweeping = true;
+    }
+    const Bucket& b = stripe.sweep_at->second;
+    const double idle_s = std::chrono::duration<double>(now - b.last).count();
+    if (b.tokens + idle_s * rate_ >= burst_) stripe.sweep_at = buckets.erase(stripe.sweep_at);
+    else ++stripe.sweep_at;
+    if (stripe.sweep_at == buckets.end()) stripe.sweeping = false;
+  }
+}
+
+void AdmissionController::release(std::size_t s, Clock::time_point t0) {
+  Shard& shard = shards_[s];
+  if (max_inflight_ != 0) {
+    // EWMA (1/8) of how long a slot is held; racy read-modify-write is fine for a hint
+    const int64_t held = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+    const int64_t avg  = shard.hold_ns.load(std::memory_order_relaxed);
+    shard.hold_ns.store(avg == 0 ? held : avg + (held - avg) / 8, std::memory_order_relaxed);
+  }
+  shard.inflight.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+AdmissionStats AdmissionController::stats() const {
+  AdmissionStats st;
+  st.admitted          = admitted_.load(std::memory_order_relaxed);
+  st.shed_shard_full   = shed_full_.load(std::memory_order_relaxed);
+  st.shed_rate_limited = shed_rate_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < shard_count_; ++i) st.inflight += shards_[i].inflight.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < kStripes; ++i) {
+    std::lock_guard<std::mutex> lk(stripes_[i].mu);
+    st.tracked_clients += stripes_[i].buckets.size();
+  }
+  return st;
+}
@@ -1,13 +1,22 @@
+#include "runtime/runtime_config.hpp"
+#ifdef __linux__
+#include "order_entry/listener.hpp"
+#endif
 #include "server/matching_engine_service.hpp"
+#include "server/replication_service.hpp"
 #include "storage/storage.hpp"
 
 #include <grpcpp/grpcpp.h>
 #include <atomic>
+#include <charconv>
 #include <chrono>
 #include <csignal>
 #include <filesystem>
 #include <iostream>
+#include <system_error>
 #include <thread>
+#include <utility>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -16,27 +25,109 @@ static void on_signal(int) { g_stop.store(true, std::memory_order_relaxed); }
 
 int main(int argc, char** argv) {
   std::string addr = "0.0.0.0:50051"; // 0.0.0.0 listens on all local interfaces
+  std::filesystem::path db_file = std::filesystem::path("db") / "matching_engine.db";
+  std::string rt_file;                 // --config <file>
+  std::vector<std::string> rt_flags;   // --rt key=value (applied after the file)
+  ReplicationConfig repl;              // --role/--standby/--repl-listen/--repl-sync/--repl-timeout-ms
+  std::string oe_tcp, oe_unix;         // --oe-tcp host:port / --oe-unix path (binary order entry)
 
   // Parse command line and flags
   for (int i = 1; i < argc; ++i) {
     std::string a = argv[i];
     if (a == "--addr" && i + 1 < argc) addr = argv[++i];
+    else if (a == "--db" && i + 1 < argc) db_file = argv[++i];   // one file per engine process
+    else if (a == "--config" && i + 1 < argc) rt_file = argv[++i];
+    else if (a == "--rt" && i + 1 < argc) rt_flags.emplace_back(argv[++i]);
+    else if (a == "--role" && i + 1 < argc) {
+      // A typo must not silently start a second primary
+      const std::string r = argv[++i];
+      if (r == "primary")      repl.role = ReplicationRole::Primary;
+      else if (r == "standby") repl.role = ReplicationRole::Standby;
+      else {
+        std::cerr << "[SERVER] ERROR: --role expects primary or standby, got: " << r << "\n";
+        return 1;
+      }
+    }
+    else if (a == "--standby" && i + 1 < argc) repl.standby_addr = argv[++i];
+    else if (a == "--repl-listen" && i + 1 < argc) repl.listen_addr = argv[++i];
+    else if (a == "--repl-sync") repl.sync_ack = true;
+    else if (a == "--repl-timeout-ms" && i + 1 < argc) {
+      const std::string v = argv[++i];
+      int ms = 0;
+      const auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), ms);
+      if (ec != std::errc{} || ptr != v.data() + v.size() || ms <= 0) {
+        std::cerr << "[SERVER] ERROR: --repl-timeout-ms expects a positive number of milliseconds, got: " << v << "\n";
+        return 1;
+      }
+      repl.ack_timeout = std::chrono::milliseconds(ms);
+    }
+    else if (a == "--oe-tcp" && i + 1 < argc) oe_tcp = argv[++i];
+    else if (a == "--oe-unix" && i + 1 < argc) oe_unix = argv[++i];
+  }
+
+  // Replication is never served on the client-facing --addr: a standby needs its own endpoint
+  if (repl.role == ReplicationRole::Standby && repl.listen_addr.empty()) {
+    std::cerr << "[SERVER] ERROR: --role standby needs --repl-listen (the primary ships events there)\n";
+    return 1;
+  }
+
+  // The order-entry loop handles orders one at a time on a single thread; waiting for the
+  // standby there would stall every connection for a round trip per order
+  if (repl.sync_ack && (!oe_tcp.empty() || !oe_unix.empty())) {
+    std::cerr << "[SERVER] ERROR: --repl-sync can't be combined with --oe-tcp/--oe-unix\n";
+    return 1;
   }
 
   try {
+    RuntimeConfig rt;
+    if (!rt_file.empty()) rt.load_file(rt_file);
+    for (const auto& kv : rt_flags) {
+      const auto eq = kv.find('=');
+      if (eq == std::string::npos) throw std::invalid_argument("--rt expects key=value, got: " + kv);
+      rt.set(kv.substr(0, eq), kv.substr(eq + 1));
+    }
+
     // Ensure directory exists and use a FILE path, not a directory
-    std::filesystem::path db_file = std::filesystem::path("db") / "matching_engine.db";
     std::error_code ec;
-    std::filesystem::create_directories(db_file.parent_path(), ec); // ok if already exists
+    if (db_file.has_parent_path())
+      std::filesystem::create_directories(db_file.parent_path(), ec); // ok if already exists
 
-    MatchingEngineServiceImpl service(db_file.string());
+    const std::vector<int> io_cpus = rt.io_cpus;
+    // The order-entry loop is the one thread that runs engine code end to end (gRPC orders
+    // run on whichever handler thread received them), so cpu.engine pins it
+    const bool oe_enabled = !oe_tcp.empty() || !oe_unix.empty();
+    const std::vector<int> oe_cpus = rt.engine_cpus.empty() ? rt.io_cpus : rt.engine_cpus;
+    if (!rt.engine_cpus.empty() && !oe_enabled)
+      std::cerr << "[SERVER] WARNING: cpu.engine only pins the binary order-entry thread"
+                   " (--oe-tcp/--oe-unix); gRPC orders run on the cpu.io threads\n";
+    const WaitStrategy oe_wait = rt.wait_for("order_entry");
+    const std::string repl_listen = repl.listen_addr;
+    const bool standby = (repl.role == ReplicationRole::Standby);
+    MatchingEngineServiceImpl service(db_file.string(), std::move(rt), std::move(repl));
+    ReplicationServiceImpl replication(service);
 
     grpc::ServerBuilder builder;
+    if (!io_cpus.empty()) {
+      // One completion queue per pinned I/O core keeps handler threads from piling onto the same CPU
+      builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::NUM_CQS,
+                                  static_cast<int>(io_cpus.size()));
+    }
     int selected_port = 0;
     builder.AddListeningPort(addr, grpc::InsecureServerCredentials(), &selected_port);
     builder.RegisterService(&service);
     std::unique_ptr<grpc::Server> server = builder.BuildAndStart();
 
+    // Replication (Apply/Promote) gets a server of its own, so clients on --addr can't reach it.
+    // Bind it to a Unix socket or a private interface: it is unauthenticated.
+    std::unique_ptr<grpc::Server> repl_server;
+    int repl_port = 0;
+    if (!repl_listen.empty()) {   // e.g. unix:/tmp/me_standby.sock for a same-host pair
+      grpc::ServerBuilder repl_builder;
+      repl_builder.AddListeningPort(repl_listen, grpc::InsecureServerCredentials(), &repl_port);
+      repl_builder.RegisterService(&replication);
+      repl_server = repl_builder.BuildAndStart();
+    }
+
     if (!server) {
       std::cerr << "[SERVER] ERROR: BuildAndStart() returned null\n";
       return 1;
@@ -45,19 +136,63 @@ int main(int argc, char** argv) {
       std::cerr << "[SERVER] ERROR: failed to bind " << addr << " (in use or permission issue)\n";
       return 1;
     }
+    if (!repl_listen.empty() && (!repl_server || repl_port == 0)) {
+      std::cerr << "[SERVER] ERROR: failed to bind replication endpoint " << repl_listen << "\n";
+      return 1;
+    }
+
+#ifdef __linux__
+    std::unique_ptr<OrderEntryListener> order_entry;
+    if (oe_enabled) {
+      order_entry = std::make_unique<OrderEntryListener>(service, OrderEntryConfig{oe_tcp, oe_unix}, oe_wait, oe_cpus);
+      order_entry->start();
+      std::cout << "[SERVER] order entry on";
+      if (!oe_tcp.empty())  std::cout << " tcp port " << order_entry->tcp_port();
+      if (!oe_unix.empty()) std::cout << " unix " << oe_unix;
+      std::cout << "\n";
+    }
+#else
+    if (oe_enabled)
+      std::cerr << "[SERVER] WARNING: binary order entry (--oe-tcp/--oe-unix) is only available on Linux\n";
+    (void)oe_wait;
+    (void)oe_cpus;
+#endif
 
-    std::cout << "[SERVER] listening on " << addr << " ; db=" << db_file.string() << "\n";
+    std::cout << "[SERVER] listening on " << addr << " ; db=" << db_file.string()
+              << " ; role=" << (standby ? "standby" : "primary");
+    if (!repl_listen.empty()) std::cout << " ; repl=" << repl_listen;
+    std::cout << "\n";
 
     std::signal(SIGINT,  on_signal);
     std::signal(SIGTERM, on_signal);
 
     std::thread stopper([&]{
-      while (!g_stop.load(std::memory_order_relaxed)) std::this_thread::sleep_for(50ms);
+      // Also reports admission control every few seconds while orders are being shed
+      AdmissionStats last;
+      auto next_report = std::chrono::steady_clock::now() + 5s;
+      while (!g_stop.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(50ms);
+        if (std::chrono::steady_clock::now() < next_report) continue;
+        next_report += 5s;
+        const AdmissionStats st = service.admission_stats();
+        if (st.shed_shard_full != last.shed_shard_full || st.shed_rate_limited != last.shed_rate_limited) {
+          std::cout << "[ADMISSION] admitted=" << st.admitted
+                    << " shed_shard_full=" << st.shed_shard_full
+                    << " shed_rate_limited=" << st.shed_rate_limited
+                    << " inflight=" << st.inflight << "\n";
+        }
+        last = st;
+      }
       server->Shutdown(std::chrono::system_clock::now() + 2s);
+      if (repl_server) repl_server->Shutdown(std::chrono::system_clock::now() + 2s);
     });
 
     server->Wait();
+    if (repl_server) repl_server->Wait();
     stopper.join();
+#ifdef __linux__
+    if (order_entry) order_entry->stop();
+#endif
     return 0;
 
   } catch (const SQLite::Exception& e) {
@@ -1,39 +1,142 @@
 #include "server/matching_engine_service.hpp"
 
 #include "domain/order.hpp"
+#include "domain/price.hpp"
 #include "domain/side.hpp"
+#include "engine/book_layout.hpp"
+#include "runtime/huge_page_arena.hpp"
+#include "runtime/thread_affinity.hpp"
 #include "storage/storage.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <iostream>
 #include <mutex>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace mat_eng = matching_engine::v1;
 using namespace std::chrono_literals;
 
 // ============================= Impl =============================
 struct MatchingEngineServiceImpl::Impl {
-  explicit Impl(std::string db_path) : storage(std::move(db_path)), next_id(1) {
+  Impl(std::string db_path, RuntimeConfig rt_cfg, ReplicationConfig repl_cfg)
+    : rt(std::move(rt_cfg)),
+      repl(std::move(repl_cfg)),
+      admission(rt),
+      pool(rt.pool_bytes, rt.huge_pages, rt.prefault),
+      storage(std::move(db_path)),
+      next_id(1),
+      role(repl.role) {
     storage.init();
     // Seed next_id_ so we don't collide with existing rows
     next_id.store(storage.load_next_oid_seq(), std::memory_order_relaxed);
+
+    // Open LIMIT orders go back on the books, so a restart keeps them cancellable and visible
+    const std::vector<Order> open = storage.load_open_limit_orders();
+    for (const Order& o : open) rest(o);
+    if (!open.empty()) std::cout << "[SERVER] restored " << open.size() << " resting orders from db\n";
+
+    if (role == ReplicationRole::Primary && !repl.standby_addr.empty())
+      replicator = std::make_unique<Replicator>(repl.standby_addr, rt.wait_for("replication"), rt.persistence_cpus);
   }
 
+  RuntimeConfig rt;                // pinning / wait / memory profile
+  ReplicationConfig repl;          // primary/standby settings
+  AdmissionController admission;   // ingress bounds + per-client rate limits
+  HugePageArena pool;              // engine memory pool (pre-faulted at startup)
   Storage storage;                 // long-lived DB handle
   std::atomic<uint64_t> next_id;   // starts at 1
-  std::mutex write_mu;             // serialize DB writes
+  std::mutex write_mu;             // serialize DB writes + book updates
+
+  // Where a resting order sits, so a cancel can find it without scanning books
+  struct RestingRef {
+    std::string symbol;
+    std::string client_id;
+    Side        side;
+    PriceQ4     price_q4;
+  };
+
+  std::unordered_map<std::string, OrderBook>  books;     // symbol -> in-memory book (write_mu)
+  std::unordered_map<std::string, RestingRef> resting;   // order_id -> location (write_mu)
+
+  std::atomic<ReplicationRole> role;
+  uint64_t repl_epoch  = 0;        // standby: epoch of the primary we follow (write_mu)
+  uint64_t applied_seq = 0;        // standby: last contiguous seq applied (write_mu)
+  bool     gap_reported = false;   // standby: logged the current epoch's unrecoverable gap (write_mu)
+  std::unique_ptr<Replicator> replicator;   // primary with a standby; declared last so it stops first
 
   // Thread-safe monotonic id generator
   std::string gen_order_id() {
     const uint64_t id = next_id.fetch_add(1, std::memory_order_relaxed);
     return "OID-" + std::to_string(id);
   }
+
+  // Standby: keep the generator ahead of replicated ids so a promotion doesn't reuse them
+  void bump_next_id_past(const std::string& order_id) {
+    if (order_id.rfind("OID-", 0) != 0) return;
+    const uint64_t seen = std::stoull(order_id.substr(4));
+    uint64_t cur = next_id.load(std::memory_order_relaxed);
+    while (cur <= seen && !next_id.compare_exchange_weak(cur, seen + 1, std::memory_order_relaxed)) {}
+  }
+
+  OrderBook& book_for(const std::string& symbol) {
+    auto it = books.find(symbol);
+    if (it == books.end())
+      it = books.try_emplace(symbol, rt.layout_for(symbol), pool.resource(), rt.ladder_ticks).first;
+    return it->second;
+  }
+
+  // Put a LIMIT order on its book and index it (write_mu held)
+  void rest(const Order& o) {
+    book_for(o.symbol).add(o);
+    resting.insert_or_assign(o.order_id, RestingRef{o.symbol, o.client_id, o.side, o.price_q4});
+  }
+
+  // Take an indexed order off its book (write_mu held). False if it wasn't resting.
+  bool unrest(const std::string& order_id) {
+    auto it = resting.find(order_id);
+    if (it == resting.end()) return false;
+    const RestingRef& ref = it->second;
+    book_for(ref.symbol).remove(ref.side, ref.price_q4, order_id);
+    resting.erase(it);
+    return true;
+  }
 };
 
+static int64_t now_ms() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Event shipped to the standby for an accepted order
+static mat_eng::ReplicationEvent make_new_order_event(const Order& o, mat_eng::OrderType type) {
+  mat_eng::ReplicationEvent ev;
+  ev.set_type(mat_eng::ReplicationEvent::NEW_ORDER);
+  ev.set_order_id(o.order_id);
+  ev.set_client_id(o.client_id);
+  ev.set_symbol(o.symbol);
+  ev.set_side(o.side);
+  ev.set_order_type(type);
+  ev.set_price_q4(o.price_q4);
+  ev.set_quantity(static_cast<int32_t>(o.quantity));
+  return ev;
+}
+
+// Event shipped for an order leaving the book: CANCEL, or WITHDRAW after a sync-ack timeout
+static mat_eng::ReplicationEvent make_close_event(mat_eng::ReplicationEvent::Type type, const std::string& order_id) {
+  mat_eng::ReplicationEvent ev;
+  ev.set_type(type);
+  ev.set_order_id(order_id);
+  return ev;
+}
+
 // ========================== API surface =========================
-MatchingEngineServiceImpl::MatchingEngineServiceImpl(std::string db_path) : d_(std::make_unique<Impl>(std::move(db_path))) {}
+MatchingEngineServiceImpl::MatchingEngineServiceImpl(std::string db_path, RuntimeConfig rt, ReplicationConfig repl)
+  : d_(std::make_unique<Impl>(std::move(db_path), std::move(rt), std::move(repl))) {}
 
 MatchingEngineServiceImpl::~MatchingEngineServiceImpl() = default;
 
@@ -43,64 +146,143 @@ grpc::Status MatchingEngineServiceImpl::SubmitOrder(
     const mat_eng::OrderRequest* req,
     mat_eng::OrderResponse* resp) {
 
-  const auto t0   = std::chrono::steady_clock::now();
-  const auto peer = ctx ? ctx->peer() : "unknown";
+  // gRPC owns its handler threads, so pin them the first time they reach us
+  pin_current_thread_once(d_->rt.io_cpus);
 
-  auto side_str = [req]() { return (req->side() == mat_eng::BUY) ? "BUY" : "SELL"; };
-  auto type_str = [req]() { return (req->order_type() == mat_eng::LIMIT) ? "LIMIT" : "MARKET"; };
+  uint32_t retry_after_ms = 0;
+  grpc::Status st = SubmitOrderDirect(*req, resp, &retry_after_ms);
+  if (ctx && retry_after_ms != 0) ctx->AddTrailingMetadata(kRetryAfterMetadataKey, std::to_string(retry_after_ms));
+  return st;
+}
 
-  // --- log ----------------------------------------------------------------
-  std::cout << "[SERVER] [SubmitOrder] ============================================================= New Order\n"
-            << " client_id=" << req->client_id()
-            << " symbol="    << req->symbol()
-            << " side="      << side_str()
-            << " type="      << type_str()
-            << " price="     << ((req->order_type() == mat_eng::LIMIT)
-                                   ? std::to_string(req->price())
-                                   : std::string("NULL"))
-            << " scale="     << req->scale()
-            << " qty="       << req->quantity()
-            << std::endl;
+// SubmitOrder body, shared with in-process front ends (no gRPC context)
+grpc::Status MatchingEngineServiceImpl::SubmitOrderDirect(
+    const mat_eng::OrderRequest& req,
+    mat_eng::OrderResponse* resp,
+    uint32_t* retry_after_ms) {
+
+  // A standby only follows the primary; tell the client to go elsewhere (or promote us)
+  if (!is_primary()) {
+    return grpc::Status(grpc::StatusCode::UNAVAILABLE, "standby: not accepting orders until promoted");
+  }
 
   // --- validation ---------------------------------------------------------
-  if (req->symbol().empty()) {
+  if (req.symbol().empty()) {
     resp->set_success(false);
     resp->set_error_message("symbol is required");
     std::cerr << "[SERVER] [SubmitOrder][reject] reason=missing_symbol\n";
     return grpc::Status::OK;
   }
-  if (req->quantity() <= 0) {
+  // SIDE_UNSPECIFIED is a valid enum value but not a side; the DB would refuse it later
+  if (req.side() != mat_eng::BUY && req.side() != mat_eng::SELL) {
+    resp->set_success(false);
+    resp->set_error_message("side must be BUY or SELL");
+    std::cerr << "[SERVER] [SubmitOrder][reject] reason=bad_side side=" << req.side() << "\n";
+    return grpc::Status::OK;
+  }
+  if (req.quantity() <= 0) {
     resp->set_success(false);
     resp->set_error_message("quantity must be > 0");
-    std::cerr << "[SERVER] [SubmitOrder][reject] reason=non_positive_qty qty=" << req->quantity() << "\n";
+    std::cerr << "[SERVER] [SubmitOrder][reject] reason=non_positive_qty qty=" << req.quantity() << "\n";
     return grpc::Status::OK;
   }
-  if (req->order_type() == mat_eng::LIMIT && req->price() <= 0) {
+  if (req.order_type() == mat_eng::LIMIT && req.price() <= 0) {
     resp->set_success(false);
     resp->set_error_message("price must be > 0 for LIMIT");
-    std::cerr << "[SERVER] [SubmitOrder][reject] reason=non_positive_price price=" << req->price() << "\n";
+    std::cerr << "[SERVER] [SubmitOrder][reject] reason=non_positive_price price=" << req.price() << "\n";
+    return grpc::Status::OK;
+  }
+  if (req.scale() < 0 || req.scale() > 18) {
+    resp->set_success(false);
+    resp->set_error_message("scale must be in 0..18");
+    std::cerr << "[SERVER] [SubmitOrder][reject] reason=bad_scale scale=" << req.scale() << "\n";
+    return grpc::Status::OK;
+  }
+  // Normalize here so an unrepresentable price is a reject, not an exception:
+  // the binary order-entry thread has no gRPC layer to catch it
+  PriceQ4 price_q4 = 0;
+  try {
+    price_q4 = normalize_to_q4(req.price(), req.scale());
+  } catch (const std::exception&) {
+    resp->set_success(false);
+    resp->set_error_message("price out of range for scale");
+    std::cerr << "[SERVER] [SubmitOrder][reject] reason=price_overflow price=" << req.price()
+              << " scale=" << req.scale() << "\n";
     return grpc::Status::OK;
   }
 
+  // --- admission: shed excess load now instead of queueing on write_mu ---
+  // After validation, so malformed requests neither spend a client's tokens nor count as load.
+  // The ticket holds a shard slot until we return (DB write + standby ack included).
+  const AdmissionController::Ticket ticket = d_->admission.admit(req.client_id(), req.symbol());
+  if (!ticket.admitted()) {
+    if (retry_after_ms) *retry_after_ms = ticket.retry_after_ms();
+    const bool full = ticket.verdict() == AdmissionController::Verdict::ShardFull;
+    return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                        std::string(full ? "overloaded: engine shard at capacity" : "rate limited: client_id over its order rate")
+                          + ", retry after " + std::to_string(ticket.retry_after_ms()) + "ms");
+  }
+
+  const auto t0 = std::chrono::steady_clock::now();
+
+  auto side_str = [&req]() { return (req.side() == mat_eng::BUY) ? "BUY" : "SELL"; };
+  auto type_str = [&req]() { return (req.order_type() == mat_eng::LIMIT) ? "LIMIT" : "MARKET"; };
+
+  // --- log ----------------------------------------------------------------
+  std::cout << "[SERVER] [SubmitOrder] ============================================================= New Order\n"
+            << " client_id=" << req.client_id()
+            << " symbol="    << req.symbol()
+            << " side="      << side_str()
+            << " type="      << type_str()
+            << " price="     << ((req.order_type() == mat_eng::LIMIT)
+                                   ? std::to_string(req.price())
+                                   : std::string("NULL"))
+            << " scale="     << req.scale()
+            << " qty="       << req.quantity()
+            << std::endl;
+
   const auto order_id = d_->gen_order_id();
   std::cout << "[SERVER] [SubmitOrder] oid=" << order_id << " validated\n";
 
   // --- Order creation -----------------------------------------------------
   Order new_order = Order::FromRaw(
       order_id,
-      req->client_id(),
-      req->symbol(),
-      req->price(),   // raw price
-      req->scale(),   // raw scale
-      req->quantity(),
-      req->side()
+      req.client_id(),
+      req.symbol(),
+      price_q4,       // already normalized
+      kTargetScale,
+      req.quantity(),
+      req.side()
   );
 
-  // --- DB write -----------------------------------------------------------
+  // --- DB write + book + replication -------------------------------------
   bool ok = false;
+  uint64_t repl_seq = 0;
   {
     std::lock_guard<std::mutex> lk(d_->write_mu); // serialize writes to SQLite
-    ok = d_->storage.insert_new_order(new_order);
+    ok = d_->storage.insert_new_order(new_order, req.order_type());
+    if (ok) {
+      if (req.order_type() == mat_eng::LIMIT) d_->rest(new_order);
+      // publish under the lock so the standby sees events in engine order
+      if (d_->replicator) repl_seq = d_->replicator->publish(make_new_order_event(new_order, req.order_type()));
+    }
+  }
+
+  // --- standby confirmation (sync mode) -----------------------------------
+  // With --repl-sync an order only counts once the standby has it. On timeout it is withdrawn
+  // (off the book, REJECTED in the db) and the withdrawal is shipped after it, so a standby
+  // that catches up late drops it too. The client gets UNAVAILABLE, never a success.
+  if (ok && repl_seq != 0 && d_->repl.sync_ack &&
+      !d_->replicator->wait_acked(repl_seq, d_->repl.ack_timeout)) {
+    {
+      std::lock_guard<std::mutex> lk(d_->write_mu);
+      d_->unrest(order_id);
+      if (!d_->storage.update_order_status(order_id, /*REJECTED*/ 4, 0, now_ms()))
+        std::cerr << "[SERVER] [SubmitOrder][error] oid=" << order_id << " withdraw: DB update failed\n";
+      d_->replicator->publish(make_close_event(mat_eng::ReplicationEvent::WITHDRAW, order_id));
+    }
+    std::cerr << "[SERVER] [SubmitOrder][reject] oid=" << order_id << " reason=standby_timeout seq=" << repl_seq << "\n";
+    return grpc::Status(grpc::StatusCode::UNAVAILABLE, "standby did not confirm in time; order withdrawn");
   }
 
   // --- response & outcome log --------------------------------------------
@@ -120,10 +302,190 @@ grpc::Status MatchingEngineServiceImpl::SubmitOrder(
   return grpc::Status::OK;
 }
 
+// RPC: CancelOrder(CancelRequest) -> CancelResponse, takes a resting LIMIT order off the book
+grpc::Status MatchingEngineServiceImpl::CancelOrder(
+    grpc::ServerContext*,
+    const mat_eng::CancelRequest* req,
+    mat_eng::CancelResponse* resp) {
+
+  pin_current_thread_once(d_->rt.io_cpus);
+  return CancelOrderDirect(*req, resp);
+}
+
+static const char* cancel_error(CancelOutcome outcome) {
+  switch (outcome) {
+    case CancelOutcome::Canceled:      return nullptr;
+    case CancelOutcome::UnknownOrder:  return "unknown order";
+    case CancelOutcome::NotOwner:      return "order belongs to another client";
+    case CancelOutcome::StorageFailed: return "DB update failed";
+  }
+  return "unknown order";
+}
+
+// CancelOrder body, shared with in-process front ends (no gRPC context)
+grpc::Status MatchingEngineServiceImpl::CancelOrderDirect(
+    const mat_eng::CancelRequest& req,
+    mat_eng::CancelResponse* resp,
+    CancelOutcome* outcome_out) {
+
+  if (!is_primary()) {
+    return grpc::Status(grpc::StatusCode::UNAVAILABLE, "standby: not accepting orders until promoted");
+  }
+
+  const std::string& order_id = req.order_id();
+  resp->set_order_id(order_id);
+  std::cout << "[SERVER] [CancelOrder] client_id=" << req.client_id() << " oid=" << order_id << "\n";
+
+  // --- lookup + DB update + book + replication ---------------------------
+  CancelOutcome outcome = CancelOutcome::Canceled;
+  uint64_t repl_seq = 0;
+  {
+    std::lock_guard<std::mutex> lk(d_->write_mu);
+    auto it = d_->resting.find(order_id);
+    if (it == d_->resting.end()) {
+      outcome = CancelOutcome::UnknownOrder;
+    } else if (it->second.client_id != req.client_id()) {
+      outcome = CancelOutcome::NotOwner;
+    } else if (!d_->storage.update_order_status(order_id, /*CANCELED*/ 3, 0, now_ms())) {
+      outcome = CancelOutcome::StorageFailed;
+    } else {
+      d_->unrest(order_id);
+      if (d_->replicator) repl_seq = d_->replicator->publish(make_close_event(mat_eng::ReplicationEvent::CANCEL, order_id));
+    }
+  }
+  if (outcome_out) *outcome_out = outcome;
+  const char* error = cancel_error(outcome);
+
+  // A cancel can't be taken back, so on timeout it stays done here; the client still gets
+  // UNAVAILABLE because after a failover the order may be live on the new primary
+  if (!error && repl_seq != 0 && d_->repl.sync_ack &&
+      !d_->replicator->wait_acked(repl_seq, d_->repl.ack_timeout)) {
+    std::cerr << "[SERVER] [CancelOrder][warn] oid=" << order_id << " outcome=standby_timeout seq=" << repl_seq << "\n";
+    return grpc::Status(grpc::StatusCode::UNAVAILABLE, "canceled here, but the standby did not confirm in time");
+  }
+
+  resp->set_success(error == nullptr);
+  if (error) {
+    resp->set_error_message(error);
+    std::cerr << "[SERVER] [CancelOrder][reject] oid=" << order_id << " reason=" << error << "\n";
+  } else {
+    std::cout << "[SERVER] [CancelOrder][ok] oid=" << order_id << " canceled\n";
+  }
+  return grpc::Status::OK;
+}
+
+// RPC: GetOrderBook(OrderBookRequest) -> OrderBookResponse, resting LIMIT orders best price first
 grpc::Status MatchingEngineServiceImpl::GetOrderBook(
     grpc::ServerContext*,
-    const mat_eng::OrderBookRequest*,
-    mat_eng::OrderBookResponse*) {
-  // TODO: implement (left blank like your original)
+    const mat_eng::OrderBookRequest* req,
+    mat_eng::OrderBookResponse* resp) {
+
+  std::lock_guard<std::mutex> lk(d_->write_mu);
+  auto it = d_->books.find(req->symbol());
+  if (it == d_->books.end()) return grpc::Status::OK;   // unknown symbol: empty book
+
+  auto dump = [](Side side, auto* out) {
+    return [side, out](PriceQ4 px, const PriceLevel& lvl) {
+      for (const auto& ro : lvl.orders) {
+        mat_eng::Order* o = out->Add();
+        o->set_order_id(ro.order_id);
+        o->set_client_id(ro.client_id);
+        o->set_price(px);
+        o->set_scale(kTargetScale);
+        o->set_quantity(static_cast<int32_t>(ro.quantity));
+        o->set_side(side);
+      }
+    };
+  };
+  it->second.for_each_level(mat_eng::BUY,  dump(mat_eng::BUY,  resp->mutable_bids()));
+  it->second.for_each_level(mat_eng::SELL, dump(mat_eng::SELL, resp->mutable_asks()));
+  return grpc::Status::OK;
+}
+
+AdmissionStats MatchingEngineServiceImpl::admission_stats() const {
+  return d_->admission.stats();
+}
+
+// ========================== replication =========================
+
+bool MatchingEngineServiceImpl::is_primary() const {
+  return d_->role.load(std::memory_order_acquire) == ReplicationRole::Primary;
+}
+
+// Standby: apply a batch from the primary, in seq order, to our own DB + book
+grpc::Status MatchingEngineServiceImpl::ApplyReplicated(
+    const mat_eng::ReplicationBatch& batch,
+    mat_eng::ReplicationAck* ack) {
+
+  // Once promoted we must not follow the old primary anymore (fencing)
+  if (is_primary()) {
+    return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION, "primary does not accept replicated events");
+  }
+
+  std::lock_guard<std::mutex> lk(d_->write_mu);
+  if (batch.epoch() != d_->repl_epoch) {
+    std::cout << "[REPL] following primary epoch=" << batch.epoch() << "\n";
+    d_->repl_epoch   = batch.epoch();
+    d_->applied_seq  = 0;
+    d_->gap_reported = false;
+  }
+
+  for (const auto& ev : batch.events()) {
+    if (ev.seq() <= d_->applied_seq) continue;          // retry of something we already have
+    if (ev.seq() != d_->applied_seq + 1) {
+      // The primary only resends what we haven't acked, so this never fills in by itself
+      if (!d_->gap_reported) {
+        std::cerr << "[REPL] gap: expected seq=" << d_->applied_seq + 1 << " got=" << ev.seq()
+                  << " ; this standby needs a copy of the primary's db and a restart of both\n";
+        d_->gap_reported = true;
+      }
+      ack->set_needs_resync(true);
+      break;                                            // the ack tells the primary where we are
+    }
+
+    if (ev.type() != mat_eng::ReplicationEvent::NEW_ORDER) {
+      const int status = ev.type() == mat_eng::ReplicationEvent::CANCEL ? /*CANCELED*/ 3 : /*REJECTED*/ 4;
+      if (!d_->storage.update_order_status(ev.order_id(), status, 0, now_ms())) {
+        std::cerr << "[REPL] apply failed seq=" << ev.seq() << " close oid=" << ev.order_id() << "\n";
+        break;
+      }
+      d_->unrest(ev.order_id());
+      d_->applied_seq = ev.seq();
+      continue;
+    }
+
+    Order o = Order::FromRaw(ev.order_id(), ev.client_id(), ev.symbol(),
+                             ev.price_q4(), kTargetScale, ev.quantity(), ev.side());
+    if (!d_->storage.insert_new_order(o, ev.order_type())) {
+      std::cerr << "[REPL] apply failed seq=" << ev.seq() << " oid=" << ev.order_id() << "\n";
+      break;
+    }
+    if (ev.order_type() == mat_eng::LIMIT) d_->rest(o);
+    d_->bump_next_id_past(o.order_id);
+    d_->applied_seq = ev.seq();
+  }
+
+  ack->set_applied_seq(d_->applied_seq);
+  return grpc::Status::OK;
+}
+
+// Standby -> primary. The book is already hot, so this is just a role flip.
+grpc::Status MatchingEngineServiceImpl::Promote(mat_eng::PromoteResponse* resp) {
+  ReplicationRole expected = ReplicationRole::Standby;
+  if (!d_->role.compare_exchange_strong(expected, ReplicationRole::Primary, std::memory_order_acq_rel)) {
+    resp->set_success(false);
+    resp->set_error_message("already primary");
+    return grpc::Status::OK;
+  }
+
+  uint64_t applied = 0;
+  {
+    std::lock_guard<std::mutex> lk(d_->write_mu);
+    applied = d_->applied_seq;
+  }
+  std::cout << "[SERVER] promoted to primary at seq=" << applied
+            << " next_oid=" << d_->next_id.load(std::memory_order_relaxed) << "\n";
+  resp->set_success(true);
+  resp->set_applied_seq(applied);
   return grpc::Status::OK;
 }
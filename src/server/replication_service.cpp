@@ -0,0 +1,19 @@
+#include "server/replication_service.hpp"
+
+namespace mat_eng = matching_engine::v1;
+
+// RPC: Apply(ReplicationBatch) -> ReplicationAck
+grpc::Status ReplicationServiceImpl::Apply(
+    grpc::ServerContext*,
+    const mat_eng::ReplicationBatch* batch,
+    mat_eng::ReplicationAck* ack) {
+  return engine_.ApplyReplicated(*batch, ack);
+}
+
+// RPC: Promote(PromoteRequest) -> PromoteResponse
+grpc::Status ReplicationServiceImpl::Promote(
+    grpc::ServerContext*,
+    const mat_eng::PromoteRequest*,
+    mat_eng::PromoteResponse* resp) {
+  return engine_.Promote(resp);
+}
@@ -0,0 +1,164 @@
+#include "server/replicator.hpp"
+
+#include "runtime/thread_affinity.hpp"
+#include "runtime/wait_strategy.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std::chrono_literals;
+
+// Retry delay while the standby is unreachable or not making progress (doubles per attempt)
+static constexpr std::chrono::milliseconds kMinBackoff = 10ms;
+static constexpr std::chrono::milliseconds kMaxBackoff = 1000ms;
+
+static uint64_t new_epoch() {
+  using namespace std::chrono;
+  return static_cast<uint64_t>(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+}
+
+// -------------------- ctor / dtor --------------------
+
+Replicator::Replicator(std::string standby_addr, WaitStrategy wait, std::vector<int> cpus)
+  : stub_(mat_eng::Replication::NewStub(
+        grpc::CreateChannel(standby_addr, grpc::InsecureChannelCredentials()))),
+    wait_(wait),
+    cpus_(std::move(cpus)),
+    epoch_(new_epoch())
+{
+  std::cout << "[REPL] shipping events to standby " << standby_addr
+            << " epoch=" << epoch_ << " wait=" << to_string(wait_) << "\n";
+  thread_ = std::thread([this] { run_(); });
+}
+
+Replicator::~Replicator() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    stop_.store(true, std::memory_order_release);
+  }
+  cv_.notify_all();
+  acked_cv_.notify_all();
+  if (thread_.joinable()) thread_.join();
+}
+
+// -------------------- producer side --------------------
+
+uint64_t Replicator::publish(mat_eng::ReplicationEvent ev) {
+  uint64_t seq;
+  bool dropped = false;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    seq = next_seq_++;
+    if (!overflowed_.load(std::memory_order_relaxed) && queue_.size() + inflight_ >= kMaxBacklog) {
+      std::cerr << "[REPL] standby backlog reached " << kMaxBacklog << " events at seq=" << seq
+                << "; dropping it. Copy this primary's db to the standby and restart both\n";
+      queue_.clear();
+      queued_.store(false, std::memory_order_release);
+      overflowed_.store(true, std::memory_order_release);
+      dropped = true;
+    }
+    if (!overflowed_.load(std::memory_order_relaxed)) {   // past the gap the standby can't use anything
+      ev.set_seq(seq);
+      queue_.push_back(std::move(ev));
+      queued_.store(true, std::memory_order_release);
+    }
+  }
+  cv_.notify_one();
+  if (dropped) acked_cv_.notify_all();   // waiters on dropped seqs fail now
+  return seq;
+}
+
+bool Replicator::wait_acked(uint64_t seq, std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto done = [&] {
+    return acked_seq_.load(std::memory_order_acquire) >= seq || overflowed_.load(std::memory_order_acquire);
+  };
+  return wait_with(wait_, lk, acked_cv_, done, done, std::chrono::steady_clock::now() + timeout) &&
+         acked_seq_.load(std::memory_order_relaxed) >= seq;
+}
+
+// -------------------- sender thread --------------------
+
+void Replicator::run_() {
+  pin_current_thread(cpus_);
+
+  std::vector<mat_eng::ReplicationEvent> inflight;   // sent but not acknowledged yet
+  bool standby_down    = false;
+  bool stalled         = false;   // standby answers but applied_seq doesn't move
+  bool resync_reported = false;
+  std::chrono::milliseconds backoff = kMinBackoff;
+
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      if (inflight.empty()) {
+        wait_with(wait_, lk, cv_,
+                  [this] { return stop_.load(std::memory_order_acquire) || queued_.load(std::memory_order_acquire); },
+                  [this] { return stop_.load(std::memory_order_relaxed) || !queue_.empty(); });
+      }
+      if (stop_.load(std::memory_order_relaxed)) {
+        if (!inflight.empty() || !queue_.empty())
+          std::cerr << "[REPL] stopping with " << inflight.size() + queue_.size() << " unacknowledged events\n";
+        return;
+      }
+      while (inflight.size() < kMaxBatch && !queue_.empty()) {
+        inflight.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+      }
+      queued_.store(!queue_.empty(), std::memory_order_release);
+      inflight_ = inflight.size();
+    }
+
+    mat_eng::ReplicationBatch batch;
+    batch.set_epoch(epoch_);
+    for (const auto& ev : inflight) *batch.add_events() = ev;
+
+    grpc::ClientContext ctx;
+    ctx.set_deadline(std::chrono::system_clock::now() + 1s);
+    mat_eng::ReplicationAck ack;
+    grpc::Status st = stub_->Apply(&ctx, batch, &ack);
+
+    if (st.ok()) {
+      if (standby_down) std::cout << "[REPL] standby reachable again\n";
+      standby_down = false;
+
+      const uint64_t applied = ack.applied_seq();
+      const std::size_t before = inflight.size();
+      inflight.erase(std::remove_if(inflight.begin(), inflight.end(),
+                                    [applied](const auto& ev) { return ev.seq() <= applied; }),
+                     inflight.end());
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (applied > acked_seq_.load(std::memory_order_relaxed)) acked_seq_.store(applied, std::memory_order_release);
+        inflight_  = inflight.size();
+      }
+      acked_cv_.notify_all();
+
+      if (ack.needs_resync() && !resync_reported) {
+        std::cerr << "[REPL] standby is missing events (applied_seq=" << applied
+                  << ") that this primary no longer holds. Copy this primary's db to the standby and"
+                  << " restart both; sync acks will time out until then\n";
+        resync_reported = true;
+      }
+      if (inflight.empty() || inflight.size() != before) {
+        if (stalled) std::cout << "[REPL] standby applying again at seq=" << applied << "\n";
+        stalled = false;
+        backoff = kMinBackoff;
+        continue;
+      }
+      // Answered but applied nothing (gap, or its own db write failed): resending at once won't help
+      if (!stalled && !ack.needs_resync())
+        std::cerr << "[REPL] standby stuck at applied_seq=" << applied << " ; retrying\n";
+      stalled = true;
+    } else if (!standby_down) {
+      // Keep the batch and retry; log only when the standby goes away, not on every attempt
+      std::cerr << "[REPL] standby unreachable code=" << st.error_code()
+                << " msg=" << st.error_message() << " ; retrying\n";
+      standby_down = true;
+    }
+
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait_for(lk, backoff, [this] { return stop_.load(std::memory_order_relaxed); });
+    backoff = std::min(backoff * 2, kMaxBackoff);
+  }
+}
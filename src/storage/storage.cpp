@@ -75,7 +75,7 @@ inline int64_t now_ms() {
 }
 
 // -------------------- writes --------------------
-bool Storage::insert_new_order(const Order& o) {
+bool Storage::insert_new_order(const Order& o, mat_eng::OrderType type) {
   try {
     SQLite::Transaction txn(db_);
 
@@ -103,7 +103,7 @@ bool Storage::insert_new_order(const Order& o) {
     stmt.bind(2,  o.client_id);
     stmt.bind(3,  o.symbol);
     stmt.bind(4,  static_cast<int>(o.side));   // proto enum → int
-    stmt.bind(5,  1);                          // order_type=LIMIT (adjust if you support more)
+    stmt.bind(5,  static_cast<int>(type));     // 0=LIMIT, 1=MARKET (matches proto)
     stmt.bind(6,  static_cast<long long>(o.price_q4));
     stmt.bind(7,  static_cast<long long>(o.quantity));
     stmt.bind(8,  0);                          // status=NEW
@@ -251,6 +251,31 @@ std::optional<int64_t> Storage::best_ask(const std::string& symbol) const
   }
 }
 
+std::vector<Order> Storage::load_open_limit_orders() const {
+  std::vector<Order> out;
+  try {
+    SQLite::Statement q(db_,
+      "SELECT order_id, client_id, symbol, side, price, remaining_quantity "
+      "FROM orders "
+      "WHERE order_type=0 AND status IN (0,1) AND price IS NOT NULL AND remaining_quantity > 0 "
+      "ORDER BY rowid");   // insertion order = time priority within a level
+
+    while (q.executeStep()) {
+      out.push_back(Order::FromRaw(q.getColumn(0).getString(),
+                                   q.getColumn(1).getString(),
+                                   q.getColumn(2).getString(),
+                                   q.getColumn(4).getInt64(),
+                                   kTargetScale,
+                                   q.getColumn(5).getInt64(),
+                                   static_cast<Side>(q.getColumn(3).getInt())));
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "[storage] load_open_limit_orders failed: " << e.what() << "\n";
+    out.clear();
+  }
+  return out;
+}
+
 uint64_t Storage::load_next_oid_seq() const {
   try {
     // order_id format assumed: "OID-<number>"
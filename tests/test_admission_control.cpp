@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "server/admission_control.hpp"
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+using Clock = AdmissionController::Clock;
+
+static RuntimeConfig limits(std::size_t max_inflight, double rate, double burst = 0) {
+  RuntimeConfig rt;
+  rt.admission_max_inflight = max_inflight;
+  rt.admission_client_rate  = rate;
+  rt.admission_client_burst = burst;
+  return rt;
+}
+
+TEST(AdmissionControl, UnlimitedByDefault) {
+  AdmissionController ac(RuntimeConfig{});
+  std::vector<AdmissionController::Ticket> held;
+  for (int i = 0; i < 1000; ++i) {
+    held.push_back(ac.admit("C1", "SYM"));
+    ASSERT_TRUE(held.back().admitted());
+  }
+  EXPECT_EQ(ac.stats().inflight, 1000u);
+  held.clear();
+  EXPECT_EQ(ac.stats().inflight, 0u);
+  EXPECT_EQ(ac.stats().admitted, 1000u);
+}
+
+TEST(AdmissionControl, ShardBoundShedsUntilASlotIsReleased) {
+  AdmissionController ac(limits(/*max_inflight=*/2, /*rate=*/0));
+  auto a = ac.admit("C1", "SYM");
+  auto b = ac.admit("C2", "SYM");
+  ASSERT_TRUE(a.admitted());
+  ASSERT_TRUE(b.admitted());
+
+  auto refused = ac.admit("C3", "SYM");
+  EXPECT_EQ(refused.verdict(), AdmissionController::Verdict::ShardFull);
+  EXPECT_GE(refused.retry_after_ms(), 1u);
+
+  a = AdmissionController::Ticket{};   // reply sent: slot freed
+  EXPECT_TRUE(ac.admit("C3", "SYM").admitted());
+
+  const AdmissionStats st = ac.stats();
+  EXPECT_EQ(st.admitted, 3u);
+  EXPECT_EQ(st.shed_shard_full, 1u);
+  EXPECT_EQ(st.inflight, 1u);   // b
+}
+
+TEST(AdmissionControl, ShardsAreIndependent) {
+  RuntimeConfig rt = limits(1, 0);
+  rt.admission_shards = 64;
+  AdmissionController ac(rt);
+
+  // Find two symbols on different shards
+  std::string other = "B0";
+  for (int i = 1; ac.shard_of(other) == ac.shard_of("A"); ++i) other = "B" + std::to_string(i);
+
+  auto a = ac.admit("C1", "A");
+  ASSERT_TRUE(a.admitted());
+  EXPECT_FALSE(ac.admit("C1", "A").admitted());
+  EXPECT_TRUE(ac.admit("C1", other).admitted());
+}
+
+TEST(AdmissionControl, TokenBucketPerClient) {
+  AdmissionController ac(limits(0, /*rate=*/10, /*burst=*/2));
+  const auto t0 = Clock::now();
+
+  EXPECT_TRUE(ac.admit("C1", "SYM", t0).admitted());
+  EXPECT_TRUE(ac.admit("C1", "SYM", t0).admitted());
+  auto refused = ac.admit("C1", "SYM", t0);
+  EXPECT_EQ(refused.verdict(), AdmissionController::Verdict::RateLimited);
+  EXPECT_EQ(refused.retry_after_ms(), 100u);   // one token every 100ms
+
+  EXPECT_TRUE(ac.admit("C2", "SYM", t0).admitted());          // other clients unaffected
+  EXPECT_FALSE(ac.admit("C1", "SYM", t0 + 50ms).admitted());
+  EXPECT_TRUE(ac.admit("C1", "SYM", t0 + 100ms).admitted());  // refilled
+  EXPECT_EQ(ac.stats().shed_rate_limited, 2u);
+}
+
+TEST(AdmissionControl, ShardFullDoesNotConsumeTokens) {
+  AdmissionController ac(limits(1, /*rate=*/1, /*burst=*/1));
+  const auto t0 = Clock::now();
+  {
+    auto held = ac.admit("C1", "SYM", t0);
+    ASSERT_TRUE(held.admitted());
+    EXPECT_EQ(ac.admit("C2", "SYM", t0).verdict(), AdmissionController::Verdict::ShardFull);
+  }
+  EXPECT_TRUE(ac.admit("C2", "SYM", t0).admitted());   // C2 still has its token
+}
+
+TEST(AdmissionControl, IdleClientBucketsAreDropped) {
+  AdmissionController ac(limits(0, /*rate=*/10, /*burst=*/1));
+  const auto t0 = Clock::now();
+  constexpr int kClients = 40'000;   // well past the per-stripe sweep threshold
+  for (int i = 0; i < kClients; ++i) ASSERT_TRUE(ac.admit("A" + std::to_string(i), "SYM", t0).admitted());
+  const uint64_t first_wave = ac.stats().tracked_clients;
+  EXPECT_EQ(first_wave, static_cast<uint64_t>(kClients));   // nobody has refilled yet
+
+  // A second later every first-wave bucket is full again; new traffic sweeps them out
+  for (int i = 0; i < kClients; ++i) ASSERT_TRUE(ac.admit("B" + std::to_string(i), "SYM", t0 + 1s).admitted());
+  EXPECT_LT(ac.stats().tracked_clients, first_wave + kClients / 2);
+}
@@ -0,0 +1,391 @@
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+#include "matching_engine.grpc.pb.h"
+#include "matching_engine.pb.h"
+#include "gateway/gateway_service.hpp"
+#include "gateway/symbol_router.hpp"
+#include "server/matching_engine_service.hpp"
+
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+using namespace std::chrono_literals;
+namespace mat_eng = matching_engine::v1;
+
+// Two engine backends (each with its own db file) behind a gateway, all on loopback
+struct GatewayFixture : ::testing::Test {
+  struct Backend {
+    std::string db_path;
+    std::unique_ptr<MatchingEngineServiceImpl> service;
+    std::unique_ptr<grpc::Server> server;
+    int port = 0;
+  };
+
+  std::vector<Backend> backends;
+  std::unique_ptr<GatewayServiceImpl> gateway;
+  std::unique_ptr<grpc::Server> gateway_server;
+  std::unique_ptr<mat_eng::MatchingEngine::Stub> stub;
+
+  void SetUp() override {
+    backends.resize(2);
+    std::vector<std::string> addrs;
+    for (std::size_t i = 0; i < backends.size(); ++i) {
+      auto& b = backends[i];
+      b.db_path = "gateway_test_backend" + std::to_string(i) + ".sqlite";
+      std::remove(b.db_path.c_str());
+      b.service = std::make_unique<MatchingEngineServiceImpl>(b.db_path);
+
+      grpc::ServerBuilder builder;
+      builder.RegisterService(b.service.get());
+      builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &b.port);
+      b.server = builder.BuildAndStart();
+      ASSERT_TRUE(b.server);
+      addrs.push_back("127.0.0.1:" + std::to_string(b.port));
+    }
+
+    SymbolRouter router(backends.size());
+    router.pin("AAA", 0);
+    router.pin("BBB", 1);
+    gateway = std::make_unique<GatewayServiceImpl>(addrs, std::move(router));
+
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.RegisterService(gateway.get());
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    gateway_server = builder.BuildAndStart();
+    ASSERT_TRUE(gateway_server);
+
+    stub = mat_eng::MatchingEngine::NewStub(
+        grpc::CreateChannel("127.0.0.1:" + std::to_string(port), grpc::InsecureChannelCredentials()));
+  }
+
+  void TearDown() override {
+    if (gateway_server) gateway_server->Shutdown();
+    for (auto& b : backends) {
+      if (b.server) b.server->Shutdown();
+      b.service.reset();
+      std::remove(b.db_path.c_str());
+    }
+  }
+
+  mat_eng::OrderResponse submit(const std::string& symbol) {
+    mat_eng::OrderRequest req;
+    req.set_client_id("C1");
+    req.set_symbol(symbol);
+    req.set_order_type(mat_eng::LIMIT);
+    req.set_side(mat_eng::BUY);
+    req.set_price(10050);
+    req.set_scale(2);
+    req.set_quantity(10);
+
+    grpc::ClientContext ctx;
+    mat_eng::OrderResponse resp;
+    auto status = stub->SubmitOrder(&ctx, req, &resp);
+    EXPECT_TRUE(status.ok()) << status.error_message();
+    return resp;
+  }
+
+  static int count_orders(const std::string& db_path, const std::string& symbol) {
+    SQLite::Database db(db_path, SQLite::OPEN_READONLY);
+    SQLite::Statement q(db, "SELECT COUNT(*) FROM orders WHERE symbol=?");
+    q.bind(1, symbol);
+    q.executeStep();
+    return q.getColumn(0).getInt();
+  }
+};
+
+TEST_F(GatewayFixture, RoutesBySymbolToOwningBackend) {
+  auto a = submit("AAA");
+  auto b = submit("BBB");
+  ASSERT_TRUE(a.success());
+  ASSERT_TRUE(b.success());
+
+  // Both backends start numbering at OID-1: the gateway keeps ids unique
+  EXPECT_EQ(a.order_id(), "0:OID-1");
+  EXPECT_EQ(b.order_id(), "1:OID-1");
+
+  EXPECT_EQ(count_orders(backends[0].db_path, "AAA"), 1);
+  EXPECT_EQ(count_orders(backends[0].db_path, "BBB"), 0);
+  EXPECT_EQ(count_orders(backends[1].db_path, "BBB"), 1);
+  EXPECT_EQ(count_orders(backends[1].db_path, "AAA"), 0);
+}
+
+TEST_F(GatewayFixture, RejectsMissingSymbolWithoutRouting) {
+  auto r = submit("");
+  EXPECT_FALSE(r.success());
+  EXPECT_EQ(r.error_message(), "symbol is required");
+}
+
+TEST(GatewayOrderIds, SplitRejectsMalformedOrOverflowingPrefix) {
+  std::size_t b = 0;
+  std::string id;
+  ASSERT_TRUE(GatewayServiceImpl::split_order_id("1:OID-7", b, id));
+  EXPECT_EQ(b, 1u);
+  EXPECT_EQ(id, "OID-7");
+
+  EXPECT_FALSE(GatewayServiceImpl::split_order_id("OID-7", b, id));
+  EXPECT_FALSE(GatewayServiceImpl::split_order_id(":OID-7", b, id));
+  EXPECT_FALSE(GatewayServiceImpl::split_order_id("1a:OID-7", b, id));
+  EXPECT_FALSE(GatewayServiceImpl::split_order_id("-1:OID-7", b, id));
+  // Would wrap to a small (valid) backend index with unchecked accumulation
+  EXPECT_FALSE(GatewayServiceImpl::split_order_id("18446744073709551617:OID-7", b, id));
+}
+
+TEST_F(GatewayFixture, StreamsEndUnimplementedAgainstEngineBackends) {
+  mat_eng::OrderUpdatesRequest req;
+  req.set_client_id("C1");
+  grpc::ClientContext ctx;
+  auto reader = stub->StreamOrderUpdates(&ctx, req);
+  mat_eng::OrderUpdate u;
+  EXPECT_FALSE(reader->Read(&u));
+  EXPECT_EQ(reader->Finish().error_code(), grpc::StatusCode::UNIMPLEMENTED);
+}
+
+// ---------------------------------------------------------------------------------------------
+// Scripted backends for what the engine doesn't serve yet (streams) and to see exactly what the
+// gateway forwards where.
+struct FakeBackend final : mat_eng::MatchingEngine::Service {
+  std::size_t index = 0;
+  int updates = 3;                              // StreamOrderUpdates: how many to send
+  std::chrono::milliseconds gap{0};             // ... with this pause before each one
+  bool hold_open = false;                       // ... then wait for cancellation instead of ending
+  grpc::Status end_with = grpc::Status::OK;     // ... or end with this status
+
+  std::atomic<bool> saw_cancel{false};
+  std::atomic<bool> stop{false};                // set before shutdown so held streams let go
+  std::atomic<int>  calls{0};
+  std::mutex mu;
+  mat_eng::CancelRequest last_cancel;
+
+  grpc::Status StreamOrderUpdates(grpc::ServerContext* ctx, const mat_eng::OrderUpdatesRequest* req,
+                                  grpc::ServerWriter<mat_eng::OrderUpdate>* writer) override {
+    ++calls;
+    for (int i = 1; i <= updates; ++i) {
+      std::this_thread::sleep_for(gap);
+      mat_eng::OrderUpdate u;
+      u.set_order_id("OID-" + std::to_string(i));
+      u.set_client_id(req->client_id());
+      if (!writer->Write(u)) break;
+    }
+    if (hold_open) {
+      while (!ctx->IsCancelled() && !stop) std::this_thread::sleep_for(1ms);
+      saw_cancel = ctx->IsCancelled();
+      return grpc::Status::CANCELLED;
+    }
+    return end_with;
+  }
+
+  grpc::Status StreamMarketData(grpc::ServerContext*, const mat_eng::MarketDataRequest* req,
+                                grpc::ServerWriter<mat_eng::MarketDataUpdate>* writer) override {
+    ++calls;
+    for (int i = 1; i <= updates; ++i) {
+      mat_eng::MarketDataUpdate u;
+      u.set_symbol(req->symbol());
+      u.set_best_bid(static_cast<int64_t>(index) * 1000 + i);   // which backend, which tick
+      writer->Write(u);
+    }
+    return grpc::Status::OK;
+  }
+
+  grpc::Status CancelOrder(grpc::ServerContext*, const mat_eng::CancelRequest* req,
+                           mat_eng::CancelResponse* resp) override {
+    ++calls;
+    std::lock_guard<std::mutex> lk(mu);
+    last_cancel = *req;
+    resp->set_order_id(req->order_id());
+    resp->set_success(true);
+    return grpc::Status::OK;
+  }
+
+  grpc::Status GetOrderBook(grpc::ServerContext*, const mat_eng::OrderBookRequest*,
+                            mat_eng::OrderBookResponse* resp) override {
+    ++calls;
+    resp->add_bids()->set_order_id("OID-9");
+    resp->add_asks()->set_order_id("OID-10");
+    return grpc::Status::OK;
+  }
+};
+
+struct FakeGatewayFixture : ::testing::Test {
+  FakeBackend fakes[2];
+  std::unique_ptr<grpc::Server> servers[2];
+  std::unique_ptr<GatewayServiceImpl> gateway;
+  std::unique_ptr<grpc::Server> gateway_server;
+  std::unique_ptr<mat_eng::MatchingEngine::Stub> stub;
+
+  void SetUp() override {
+    std::vector<std::string> addrs;
+    for (std::size_t i = 0; i < 2; ++i) {
+      fakes[i].index = i;
+      int port = 0;
+      grpc::ServerBuilder builder;
+      builder.RegisterService(&fakes[i]);
+      builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+      servers[i] = builder.BuildAndStart();
+      ASSERT_TRUE(servers[i]);
+      addrs.push_back("127.0.0.1:" + std::to_string(port));
+    }
+
+    SymbolRouter router(2);
+    router.pin("AAA", 0);
+    router.pin("BBB", 1);
+    gateway = std::make_unique<GatewayServiceImpl>(addrs, std::move(router));
+
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.RegisterService(gateway.get());
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    gateway_server = builder.BuildAndStart();
+    ASSERT_TRUE(gateway_server);
+    stub = mat_eng::MatchingEngine::NewStub(
+        grpc::CreateChannel("127.0.0.1:" + std::to_string(port), grpc::InsecureChannelCredentials()));
+  }
+
+  void TearDown() override {
+    for (auto& f : fakes) f.stop = true;
+    if (gateway_server) gateway_server->Shutdown();
+    for (auto& s : servers) if (s) s->Shutdown();
+  }
+
+  static bool eventually(const std::atomic<bool>& flag) {
+    for (int i = 0; i < 2000 && !flag; ++i) std::this_thread::sleep_for(1ms);
+    return flag;
+  }
+};
+
+TEST_F(FakeGatewayFixture, OrderUpdatesAreMergedFromEveryBackendInPerBackendOrder) {
+  for (auto& f : fakes) { f.updates = 20; f.gap = 2ms; }
+
+  mat_eng::OrderUpdatesRequest req;
+  req.set_client_id("C1");
+  grpc::ClientContext ctx;
+  auto reader = stub->StreamOrderUpdates(&ctx, req);
+
+  std::vector<std::string> merged;
+  mat_eng::OrderUpdate u;
+  while (reader->Read(&u)) {
+    EXPECT_EQ(u.client_id(), "C1");
+    merged.push_back(u.order_id());
+  }
+  ASSERT_TRUE(reader->Finish().ok());
+  ASSERT_EQ(merged.size(), 40u);
+
+  // Each backend's updates arrive qualified and in its own order...
+  int next[2] = {1, 1};
+  for (const auto& id : merged) {
+    std::size_t b = 0;
+    std::string oid;
+    ASSERT_TRUE(GatewayServiceImpl::split_order_id(id, b, oid)) << id;
+    ASSERT_LT(b, 2u);
+    EXPECT_EQ(oid, "OID-" + std::to_string(next[b]++));
+  }
+  // ... and both backends are read concurrently, not one after the other
+  const auto first_b1 = std::find_if(merged.begin(), merged.end(), [](const std::string& id) { return id[0] == '1'; });
+  const auto last_b0  = std::find_if(merged.rbegin(), merged.rend(), [](const std::string& id) { return id[0] == '0'; });
+  EXPECT_LT(first_b1 - merged.begin(), merged.rend() - last_b0 - 1);
+}
+
+TEST_F(FakeGatewayFixture, BackendErrorEndsTheMergedStreamAndCancelsTheRest) {
+  fakes[0].updates   = 1;
+  fakes[0].hold_open = true;
+  fakes[1].updates   = 1;
+  fakes[1].gap       = 20ms;   // let backend 0's update through first
+  fakes[1].end_with  = grpc::Status(grpc::StatusCode::INTERNAL, "backend 1 broke");
+
+  mat_eng::OrderUpdatesRequest req;
+  req.set_client_id("C1");
+  grpc::ClientContext ctx;
+  ctx.set_deadline(std::chrono::system_clock::now() + 5s);
+  auto reader = stub->StreamOrderUpdates(&ctx, req);
+
+  int received = 0;
+  mat_eng::OrderUpdate u;
+  while (reader->Read(&u)) ++received;
+  const grpc::Status st = reader->Finish();
+  EXPECT_EQ(received, 2);
+  EXPECT_EQ(st.error_code(), grpc::StatusCode::INTERNAL);
+  EXPECT_EQ(st.error_message(), "backend 1 broke");
+  EXPECT_TRUE(eventually(fakes[0].saw_cancel));
+}
+
+TEST_F(FakeGatewayFixture, ClientCancelReachesEveryBackend) {
+  for (auto& f : fakes) { f.updates = 1; f.hold_open = true; }
+
+  mat_eng::OrderUpdatesRequest req;
+  req.set_client_id("C1");
+  grpc::ClientContext ctx;
+  auto reader = stub->StreamOrderUpdates(&ctx, req);
+
+  mat_eng::OrderUpdate u;
+  ASSERT_TRUE(reader->Read(&u));
+  ASSERT_TRUE(reader->Read(&u));
+  ctx.TryCancel();
+  while (reader->Read(&u)) {}
+  EXPECT_EQ(reader->Finish().error_code(), grpc::StatusCode::CANCELLED);
+  EXPECT_TRUE(eventually(fakes[0].saw_cancel));
+  EXPECT_TRUE(eventually(fakes[1].saw_cancel));
+}
+
+TEST_F(FakeGatewayFixture, MarketDataIsProxiedFromTheOwningBackendOnly) {
+  mat_eng::MarketDataRequest req;
+  req.set_symbol("BBB");
+  grpc::ClientContext ctx;
+  auto reader = stub->StreamMarketData(&ctx, req);
+
+  std::vector<int64_t> bids;
+  mat_eng::MarketDataUpdate u;
+  while (reader->Read(&u)) {
+    EXPECT_EQ(u.symbol(), "BBB");
+    bids.push_back(u.best_bid());
+  }
+  ASSERT_TRUE(reader->Finish().ok());
+  EXPECT_EQ(bids, (std::vector<int64_t>{1001, 1002, 1003}));
+  EXPECT_EQ(fakes[0].calls, 0);
+}
+
+TEST_F(FakeGatewayFixture, CancelGoesToTheBackendNamedInTheOrderId) {
+  auto cancel = [&](const std::string& order_id) {
+    mat_eng::CancelRequest req;
+    req.set_client_id("C1");
+    req.set_order_id(order_id);
+    grpc::ClientContext ctx;
+    mat_eng::CancelResponse resp;
+    EXPECT_TRUE(stub->CancelOrder(&ctx, req, &resp).ok());
+    return resp;
+  };
+
+  const auto ok = cancel("1:OID-5");
+  EXPECT_TRUE(ok.success());
+  EXPECT_EQ(ok.order_id(), "1:OID-5");   // echoed back qualified
+  EXPECT_EQ(fakes[0].calls, 0);
+  ASSERT_EQ(fakes[1].calls, 1);
+  {
+    std::lock_guard<std::mutex> lk(fakes[1].mu);
+    EXPECT_EQ(fakes[1].last_cancel.order_id(), "OID-5");
+    EXPECT_EQ(fakes[1].last_cancel.client_id(), "C1");
+  }
+
+  // No such backend / no prefix: answered by the gateway, nothing forwarded
+  EXPECT_EQ(cancel("7:OID-5").error_message(), "unknown order");
+  EXPECT_EQ(cancel("OID-5").error_message(), "unknown order");
+  EXPECT_EQ(fakes[0].calls + fakes[1].calls, 1);
+}
+
+TEST_F(FakeGatewayFixture, OrderBookComesFromTheSymbolsBackendWithQualifiedIds) {
+  mat_eng::OrderBookRequest req;
+  req.set_symbol("AAA");
+  grpc::ClientContext ctx;
+  mat_eng::OrderBookResponse book;
+  ASSERT_TRUE(stub->GetOrderBook(&ctx, req, &book).ok());
+  ASSERT_EQ(book.bids_size(), 1);
+  ASSERT_EQ(book.asks_size(), 1);
+  EXPECT_EQ(book.bids(0).order_id(), "0:OID-9");
+  EXPECT_EQ(book.asks(0).order_id(), "0:OID-10");
+  EXPECT_EQ(fakes[0].calls, 1);
+  EXPECT_EQ(fakes[1].calls, 0);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "engine/book_layout.hpp"
+#include "engine/occupancy_bitmap.hpp"
+#include "engine/order_book.hpp"
+#include "engine/tick_ladder_book.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <memory_resource>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace mat_eng = matching_engine::v1;
+
+using Levels = std::vector<std::pair<PriceQ4, int64_t>>;   // (price, total qty), best first
+
+template <class Book>
+static Levels levels(const Book& b, Side side) {
+  Levels out;
+  b.for_each_level(side, [&](PriceQ4 px, const PriceLevel& lvl) { out.emplace_back(px, lvl.total_qty); });
+  return out;
+}
+
+static Order limit(int n, Side side, PriceQ4 px, int64_t qty = 1) {
+  return Order::FromRaw("OID-" + std::to_string(n), "C1", "SYM", px, kTargetScale, qty, side);
+}
+
+TEST(OccupancyBitmap, NextPrevAcrossWords) {
+  OccupancyBitmap bm(10000);
+  EXPECT_TRUE(bm.empty());
+  EXPECT_EQ(bm.first(), OccupancyBitmap::npos);
+  EXPECT_EQ(bm.last(),  OccupancyBitmap::npos);
+
+  for (std::size_t i : {3u, 64u, 4095u, 4096u, 9999u}) bm.set(i);
+  EXPECT_EQ(bm.first(), 3u);
+  EXPECT_EQ(bm.last(),  9999u);
+  EXPECT_EQ(bm.next(4),    64u);
+  EXPECT_EQ(bm.next(65),   4095u);
+  EXPECT_EQ(bm.next(4097), 9999u);
+  EXPECT_EQ(bm.prev(9998), 4096u);
+  EXPECT_EQ(bm.prev(4095), 4095u);
+  EXPECT_EQ(bm.prev(63),   3u);
+  EXPECT_EQ(bm.prev(2),    OccupancyBitmap::npos);
+
+  bm.clear(4096);
+  bm.clear(4095);
+  EXPECT_EQ(bm.next(65),   9999u);   // summary bit cleared with the last leaf bit
+  EXPECT_EQ(bm.prev(9998), 64u);
+}
+
+TEST(TickLadderBook, BestPricesAndFifo) {
+  TickLadderBook book;
+  book.add(limit(1, mat_eng::BUY,  100000, 5));
+  book.add(limit(2, mat_eng::BUY,  100010, 7));
+  book.add(limit(3, mat_eng::BUY,  100010, 1));
+  book.add(limit(4, mat_eng::SELL, 100020, 2));
+
+  EXPECT_EQ(book.best_bid(), 100010);
+  EXPECT_EQ(book.best_ask(), 100020);
+  EXPECT_EQ(levels(book, mat_eng::BUY), (Levels{{100010, 8}, {100000, 5}}));
+
+  std::vector<std::string> ids;
+  book.for_each_level(mat_eng::BUY, [&](PriceQ4, const PriceLevel& lvl) {
+    for (const auto& o : lvl.orders) ids.push_back(o.order_id);
+  });
+  EXPECT_EQ(ids, (std::vector<std::string>{"OID-2", "OID-3", "OID-1"}));
+}
+
+TEST(TickLadderBook, RecentersAndSpillsOutsideWindow) {
+  TickLadderBook book(std::pmr::get_default_resource(), /*ticks=*/64);
+  book.add(limit(1, mat_eng::SELL, 1000));
+  book.add(limit(2, mat_eng::SELL, 1040));      // outside the first window: recenter
+  EXPECT_EQ(book.asks().overflow_levels(), 0u);
+  book.add(limit(3, mat_eng::SELL, 5000));      // can't fit with 1000..1040: overflow
+  EXPECT_EQ(book.asks().overflow_levels(), 1u);
+  book.add(limit(4, mat_eng::SELL, 900));       // below everything: spills too
+
+  EXPECT_EQ(book.best_ask(), 900);
+  EXPECT_EQ(levels(book, mat_eng::SELL), (Levels{{900, 1}, {1000, 1}, {1040, 1}, {5000, 1}}));
+}
+
+TEST(TickLadderBook, ExtremePricesDontOverflowTheWindow) {
+  constexpr PriceQ4 kMax = std::numeric_limits<PriceQ4>::max();
+  TickLadderBook book;
+  book.add(limit(1, mat_eng::BUY, 1));               // window clamped at 0
+  book.add(limit(2, mat_eng::BUY, kMax - 10));       // far away: overflow map
+  EXPECT_EQ(book.bids().base(), 0);
+  EXPECT_EQ(book.bids().overflow_levels(), 1u);
+  EXPECT_EQ(book.best_bid(), kMax - 10);
+  EXPECT_EQ(levels(book, mat_eng::BUY), (Levels{{kMax - 10, 1}, {1, 1}}));
+
+  ASSERT_TRUE(book.remove(mat_eng::BUY, 1, "OID-1"));
+  book.add(limit(3, mat_eng::BUY, kMax - 20));       // recenters at the top of the range
+  EXPECT_EQ(book.bids().overflow_levels(), 0u);
+  EXPECT_EQ(levels(book, mat_eng::BUY), (Levels{{kMax - 10, 1}, {kMax - 20, 1}}));
+
+  book.add(limit(4, mat_eng::SELL, -5));             // never on the ladder
+  EXPECT_EQ(book.asks().overflow_levels(), 1u);
+  EXPECT_EQ(book.best_ask(), -5);
+}
+
+// Counts what a book asks of its memory resource
+class CountingResource : public std::pmr::memory_resource {
+public:
+  std::size_t outstanding = 0;
+  std::size_t largest     = 0;   // biggest single allocation since the last reset_largest()
+  void reset_largest() { largest = 0; }
+
+private:
+  void* do_allocate(std::size_t n, std::size_t align) override {
+    outstanding += n;
+    largest = std::max(largest, n);
+    return std::pmr::new_delete_resource()->allocate(n, align);
+  }
+  void do_deallocate(void* p, std::size_t n, std::size_t align) override {
+    outstanding -= n;
+    std::pmr::new_delete_resource()->deallocate(p, n, align);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+};
+
+TEST(TickLadderBook, RecenterReusesTheLadder) {
+  CountingResource mr;
+  TickLadderBook book(&mr, /*ticks=*/64);
+  book.add(limit(1, mat_eng::BUY, 1000));
+  const std::size_t steady = mr.outstanding;
+  mr.reset_largest();
+
+  // 1000 stays; 960 and 1040 can't share a window with each other, so every add recenters
+  for (int n = 2; n < 2000; ++n) {
+    const PriceQ4 px = (n % 2) ? 1040 : 960;
+    book.add(limit(n, mat_eng::BUY, px));
+    ASSERT_EQ(book.bids().overflow_levels(), 0u);
+    ASSERT_EQ(levels(book, mat_eng::BUY).size(), 2u);
+    ASSERT_TRUE(book.remove(mat_eng::BUY, px, "OID-" + std::to_string(n)));
+  }
+  EXPECT_EQ(levels(book, mat_eng::BUY), (Levels{{1000, 1}}));
+  EXPECT_LT(mr.largest, 64 * sizeof(PriceLevel));       // never a new level array
+  EXPECT_LE(mr.outstanding, steady + 4 * sizeof(RestingOrder));
+}
+
+TEST(OrderBookLayouts, RemoveMovesBestAndDropsEmptyLevels) {
+  for (BookLayout layout : {BookLayout::Map, BookLayout::TickLadder}) {
+    OrderBook book(layout, std::pmr::get_default_resource(), 64);
+    book.add(limit(1, mat_eng::BUY, 1000, 5));
+    book.add(limit(2, mat_eng::BUY, 1010, 7));
+    book.add(limit(3, mat_eng::BUY, 1010, 1));
+    book.add(limit(4, mat_eng::BUY, 9000, 2));   // outside the ladder window
+
+    EXPECT_FALSE(book.remove(mat_eng::BUY, 1010, "OID-1").has_value());   // wrong price
+    EXPECT_EQ(book.remove(mat_eng::BUY, 9000, "OID-4"), 2);
+    EXPECT_EQ(book.remove(mat_eng::BUY, 1010, "OID-2"), 7);
+    EXPECT_EQ(book.best_bid(), 1010);
+    EXPECT_EQ(book.remove(mat_eng::BUY, 1010, "OID-3"), 1);
+    EXPECT_EQ(book.best_bid(), 1000);
+    EXPECT_EQ(levels(book, mat_eng::BUY), (Levels{{1000, 5}}));
+    EXPECT_EQ(book.order_count(), 1u);
+  }
+}
+
+// Same random flow into both layouts must give the same book
+TEST(OrderBookLayouts, LadderMatchesMap) {
+  MapOrderBook   map_book;
+  TickLadderBook ladder(std::pmr::get_default_resource(), /*ticks=*/256);
+
+  std::mt19937_64 rng(42);
+  std::normal_distribution<double> near(0.0, 40.0);
+  std::uniform_int_distribution<int> far(-5000, 5000);
+  for (int n = 0; n < 5000; ++n) {
+    const bool buy = (n % 2) == 0;
+    const PriceQ4 mid = 1'000'000 + n / 10;                 // slow drift forces recentering
+    const PriceQ4 off = (n % 50 == 0) ? far(rng) : static_cast<PriceQ4>(near(rng));
+    const PriceQ4 px  = buy ? mid - 1 - std::abs(off) : mid + 1 + std::abs(off);
+    const Order o = limit(n, buy ? mat_eng::BUY : mat_eng::SELL, px, 1 + n % 7);
+    map_book.add(o);
+    ladder.add(o);
+
+    ASSERT_EQ(map_book.best_bid(), ladder.best_bid()) << "after order " << n;
+    ASSERT_EQ(map_book.best_ask(), ladder.best_ask()) << "after order " << n;
+  }
+  EXPECT_EQ(levels(map_book, mat_eng::BUY),  levels(ladder, mat_eng::BUY));
+  EXPECT_EQ(levels(map_book, mat_eng::SELL), levels(ladder, mat_eng::SELL));
+  EXPECT_EQ(map_book.order_count(), ladder.order_count());
+}
+
+TEST(OrderBookLayouts, SelectedPerSymbol) {
+  RuntimeConfig rt;
+  rt.set("book.layout.AAPL", "tick_ladder");
+  OrderBook aapl(rt.layout_for("AAPL"), std::pmr::get_default_resource(), rt.ladder_ticks);
+  OrderBook other(rt.layout_for("XYZ"), std::pmr::get_default_resource(), rt.ladder_ticks);
+  EXPECT_EQ(aapl.layout(),  BookLayout::TickLadder);
+  EXPECT_EQ(other.layout(), BookLayout::Map);
+
+  aapl.add(limit(1, mat_eng::BUY, 1234));
+  EXPECT_EQ(aapl.best_bid(), 1234);
+  EXPECT_FALSE(aapl.best_ask().has_value());
+}
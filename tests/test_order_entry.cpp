@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include "order_entry/client.hpp"
+#include "order_entry/listener.hpp"
+#include "order_entry/protocol.hpp"
+#include "server/matching_engine_service.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace mat_eng = matching_engine::v1;
+
+TEST(OrderEntryProtocol, RoundTripsAndFrames) {
+  oe::NewOrder m{7, "CLIENT-1", "AAPL", 2, 0, 2, 10050, 25};
+  uint8_t buf[oe::kMaxMessageSize * 2];
+  const std::size_t n = oe::encode(m, buf);
+  ASSERT_EQ(n, oe::kNewOrderSize);
+
+  oe::MsgType type{};
+  std::size_t size = 0;
+  EXPECT_EQ(oe::peek_frame(buf, n - 1, type, size), oe::Frame::Incomplete);
+  ASSERT_EQ(oe::peek_frame(buf, n, type, size), oe::Frame::Ready);
+  EXPECT_EQ(type, oe::MsgType::NewOrder);
+
+  const oe::NewOrder back = oe::decode_new_order(buf);
+  EXPECT_EQ(back.client_seq, 7u);
+  EXPECT_EQ(back.client_id, "CLIENT-1");
+  EXPECT_EQ(back.symbol, "AAPL");
+  EXPECT_EQ(back.side, 2);
+  EXPECT_EQ(back.price, 10050);
+  EXPECT_EQ(back.quantity, 25);
+
+  oe::encode(oe::Ack{8, 42, oe::MsgType::CancelOrder}, buf);
+  const oe::Ack ack = oe::decode_ack(buf);
+  EXPECT_EQ(ack.order_id, 42u);
+  EXPECT_EQ(ack.acked, oe::MsgType::CancelOrder);
+
+  oe::encode(oe::Reject{9, oe::RejectReason::Throttled, 15, "slow down"}, buf);
+  const oe::Reject rj = oe::decode_reject(buf);
+  EXPECT_EQ(rj.reason, oe::RejectReason::Throttled);
+  EXPECT_EQ(rj.retry_after_ms, 15u);
+  EXPECT_EQ(rj.text, "slow down");
+
+  buf[3] = 99;   // wrong version
+  EXPECT_EQ(oe::peek_frame(buf, oe::kRejectSize, type, size), oe::Frame::Malformed);
+
+  EXPECT_EQ(oe::wire_order_id("OID-42"), 42u);
+  EXPECT_EQ(oe::wire_order_id("1:OID-42"), 0u);
+  EXPECT_EQ(oe::engine_order_id(42), "OID-42");
+}
+
+struct OrderEntryFixture : ::testing::Test {
+  std::string db_path   = "/tmp/order_entry_test.sqlite";
+  std::string unix_path = "/tmp/order_entry_test.sock";
+  std::unique_ptr<MatchingEngineServiceImpl> service;
+  std::unique_ptr<OrderEntryListener> listener;
+
+  void SetUp() override {
+    std::remove(db_path.c_str());
+    service  = std::make_unique<MatchingEngineServiceImpl>(db_path);
+    listener = std::make_unique<OrderEntryListener>(*service, OrderEntryConfig{"127.0.0.1:0", unix_path});
+    listener->start();
+    ASSERT_NE(listener->tcp_port(), 0);
+  }
+
+  void TearDown() override {
+    listener.reset();
+    service.reset();
+    std::remove(db_path.c_str());
+  }
+
+  static oe::NewOrder buy(uint64_t seq, int64_t price, int32_t qty = 10) {
+    return oe::NewOrder{seq, "C1", "SYM", mat_eng::BUY, mat_eng::LIMIT, 2, price, qty};
+  }
+};
+
+TEST_F(OrderEntryFixture, PipelinedOrdersAreAckedInOrderOverTcp) {
+  auto client = oe::Client::connect_tcp("127.0.0.1", listener->tcp_port());
+  for (uint64_t seq = 1; seq <= 50; ++seq) client.send(buy(seq, 10000 + static_cast<int64_t>(seq)));
+  client.flush();
+
+  for (uint64_t seq = 1; seq <= 50; ++seq) {
+    auto msg = client.read();
+    ASSERT_TRUE(std::holds_alternative<oe::Ack>(msg)) << "seq " << seq;
+    const auto& ack = std::get<oe::Ack>(msg);
+    EXPECT_EQ(ack.client_seq, seq);
+    EXPECT_EQ(ack.acked, oe::MsgType::NewOrder);
+    EXPECT_EQ(ack.order_id, seq);   // fresh db: OID-1, OID-2, ...
+  }
+
+  mat_eng::OrderBookRequest req;
+  req.set_symbol("SYM");
+  mat_eng::OrderBookResponse book;
+  ASSERT_TRUE(service->GetOrderBook(nullptr, &req, &book).ok());
+  EXPECT_EQ(book.bids_size(), 50);
+}
+
+TEST_F(OrderEntryFixture, InvalidOrderIsRejectedOverUnixSocket) {
+  auto client = oe::Client::connect_unix(unix_path);
+  client.send(buy(1, 10000, /*qty=*/0));
+  auto msg = client.read();
+  ASSERT_TRUE(std::holds_alternative<oe::Reject>(msg));
+  const auto& rj = std::get<oe::Reject>(msg);
+  EXPECT_EQ(rj.client_seq, 1u);
+  EXPECT_EQ(rj.reason, oe::RejectReason::Invalid);
+  EXPECT_EQ(rj.text, "quantity must be > 0");
+}
+
+TEST_F(OrderEntryFixture, UnspecifiedSideIsInvalid) {
+  auto client = oe::Client::connect_tcp("127.0.0.1", listener->tcp_port());
+  client.send(oe::NewOrder{1, "C1", "SYM", mat_eng::SIDE_UNSPECIFIED, mat_eng::LIMIT, 2, 100, 1});
+  auto msg = client.read();
+  ASSERT_TRUE(std::holds_alternative<oe::Reject>(msg));
+  EXPECT_EQ(std::get<oe::Reject>(msg).reason, oe::RejectReason::Invalid);
+  EXPECT_EQ(std::get<oe::Reject>(msg).text, "side must be BUY or SELL");
+}
+
+TEST_F(OrderEntryFixture, OutOfRangeScaleIsRejectedAndLoopSurvives) {
+  auto client = oe::Client::connect_tcp("127.0.0.1", listener->tcp_port());
+  client.send(oe::NewOrder{1, "C1", "SYM", mat_eng::BUY, mat_eng::LIMIT, /*scale=*/19, 100, 1});
+  auto msg = client.read();
+  ASSERT_TRUE(std::holds_alternative<oe::Reject>(msg));
+  EXPECT_EQ(std::get<oe::Reject>(msg).reason, oe::RejectReason::Invalid);
+  EXPECT_EQ(std::get<oe::Reject>(msg).text, "scale must be in 0..18");
+
+  // Fits the scale but not Q4 int64: also a reject, not an exception
+  client.send(oe::NewOrder{2, "C1", "SYM", mat_eng::BUY, mat_eng::LIMIT, /*scale=*/0, INT64_MAX, 1});
+  msg = client.read();
+  ASSERT_TRUE(std::holds_alternative<oe::Reject>(msg));
+  EXPECT_EQ(std::get<oe::Reject>(msg).reason, oe::RejectReason::Invalid);
+
+  client.send(buy(3, 10000));
+  EXPECT_TRUE(std::holds_alternative<oe::Ack>(client.read()));
+}
+
+TEST_F(OrderEntryFixture, OverlongFieldsThrowInsteadOfTruncating) {
+  auto client = oe::Client::connect_tcp("127.0.0.1", listener->tcp_port());
+  const std::string id16(oe::kClientIdLen, 'C');
+  const std::string sym12(oe::kSymbolLen, 'S');
+  EXPECT_THROW(client.send(oe::NewOrder{1, id16 + "X", "SYM", mat_eng::BUY, mat_eng::LIMIT, 2, 100, 1}),
+               std::invalid_argument);
+  EXPECT_THROW(client.send(oe::NewOrder{2, "C1", sym12 + "X", mat_eng::BUY, mat_eng::LIMIT, 2, 100, 1}),
+               std::invalid_argument);
+  EXPECT_THROW(client.send(oe::CancelOrder{3, 1, id16 + "X"}), std::invalid_argument);
+
+  // Exactly the field width still fits, and nothing from the refused sends went out
+  client.send(oe::NewOrder{4, id16, sym12, mat_eng::BUY, mat_eng::LIMIT, 2, 100, 1});
+  auto msg = client.read();
+  ASSERT_TRUE(std::holds_alternative<oe::Ack>(msg));
+  EXPECT_EQ(std::get<oe::Ack>(msg).client_seq, 4u);
+}
+
+TEST_F(OrderEntryFixture, FloodWithoutReadingIsThrottledNotDropped) {
+  // Raw socket: the writer pushes far more than the reply high-water mark before the reader
+  // starts, so the listener has to pause and resume this connection
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  ASSERT_GE(fd, 0);
+  sockaddr_un sa{};
+  sa.sun_family = AF_UNIX;
+  std::memcpy(sa.sun_path, unix_path.c_str(), unix_path.size() + 1);
+  ASSERT_EQ(::connect(fd, reinterpret_cast<sockaddr*>(&sa), sizeof sa), 0);
+
+  constexpr uint64_t kOrders = 20000;   // ~480 KB of acks
+  std::thread writer([&] {
+    std::vector<uint8_t> buf(kOrders * oe::kNewOrderSize);
+    for (uint64_t seq = 1; seq <= kOrders; ++seq)
+      oe::encode(buy(seq, 10000), buf.data() + (seq - 1) * oe::kNewOrderSize);
+    for (std::size_t off = 0; off < buf.size();) {
+      const ssize_t n = ::send(fd, buf.data() + off, buf.size() - off, MSG_NOSIGNAL);
+      if (n <= 0) return;
+      off += static_cast<std::size_t>(n);
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::vector<uint8_t> in;
+  uint8_t chunk[4096];
+  uint64_t next = 1;
+  while (next <= kOrders) {
+    const ssize_t n = ::recv(fd, chunk, sizeof chunk, 0);
+    ASSERT_GT(n, 0) << "connection closed at seq " << next;
+    in.insert(in.end(), chunk, chunk + n);
+    std::size_t off = 0;
+    oe::MsgType type{};
+    std::size_t size = 0;
+    while (oe::peek_frame(in.data() + off, in.size() - off, type, size) == oe::Frame::Ready) {
+      ASSERT_EQ(type, oe::MsgType::Ack);
+      ASSERT_EQ(oe::decode_ack(in.data() + off).client_seq, next++);
+      off += size;
+    }
+    in.erase(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(off));
+  }
+  writer.join();
+  ::close(fd);
+}
+
+TEST_F(OrderEntryFixture, CancelAcksOnceThenUnknown) {
+  auto client = oe::Client::connect_tcp("127.0.0.1", listener->tcp_port());
+  client.send(buy(1, 10000));
+  auto placed = client.read();
+  ASSERT_TRUE(std::holds_alternative<oe::Ack>(placed));
+  const uint64_t oid = std::get<oe::Ack>(placed).order_id;
+
+  client.send(oe::CancelOrder{2, oid, "C1"});
+  client.send(oe::CancelOrder{3, oid, "C1"});
+  auto first  = client.read();
+  auto second = client.read();
+  ASSERT_TRUE(std::holds_alternative<oe::Ack>(first));
+  EXPECT_EQ(std::get<oe::Ack>(first).acked, oe::MsgType::CancelOrder);
+  ASSERT_TRUE(std::holds_alternative<oe::Reject>(second));
+  EXPECT_EQ(std::get<oe::Reject>(second).client_seq, 3u);
+  EXPECT_EQ(std::get<oe::Reject>(second).reason, oe::RejectReason::UnknownOrder);
+}
+
+TEST(OrderEntryAdmission, ShedOrderIsThrottledWithRetryHint) {
+  const std::string db_path = "/tmp/order_entry_admission_test.sqlite";
+  std::remove(db_path.c_str());
+  {
+    RuntimeConfig rt;
+    rt.set("admission.client_rate", "1");
+    rt.set("admission.client_burst", "1");
+    MatchingEngineServiceImpl service(db_path, rt);
+    OrderEntryListener listener(service, OrderEntryConfig{"127.0.0.1:0", ""});
+    listener.start();
+
+    auto client = oe::Client::connect_tcp("127.0.0.1", listener.tcp_port());
+    client.send(oe::NewOrder{1, "C1", "SYM", mat_eng::BUY, mat_eng::LIMIT, 2, 100, 1});
+    client.send(oe::NewOrder{2, "C1", "SYM", mat_eng::BUY, mat_eng::LIMIT, 2, 100, 1});
+    EXPECT_TRUE(std::holds_alternative<oe::Ack>(client.read()));
+    auto shed = client.read();
+    ASSERT_TRUE(std::holds_alternative<oe::Reject>(shed));
+    EXPECT_EQ(std::get<oe::Reject>(shed).reason, oe::RejectReason::Throttled);
+    EXPECT_GT(std::get<oe::Reject>(shed).retry_after_ms, 0u);
+  }
+  std::remove(db_path.c_str());
+}
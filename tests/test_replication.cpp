@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+#include "matching_engine.grpc.pb.h"
+#include "matching_engine.pb.h"
+#include "server/matching_engine_service.hpp"
+#include "server/replication_service.hpp"
+#include "server/replicator.hpp"
+
+#include <cstdio>
+#include <filesystem>
+
+using namespace std::chrono_literals;
+namespace mat_eng = matching_engine::v1;
+
+static std::string temp_db_path(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Primary (sync ack) -> standby, both on loopback, each with its own db file. Like `server`,
+// every node serves Replication on a server of its own, apart from the client-facing one.
+struct ReplicationFixture : ::testing::Test {
+  struct Node {
+    std::string db_path;
+    std::unique_ptr<MatchingEngineServiceImpl> service;
+    std::unique_ptr<ReplicationServiceImpl> replication;
+    std::unique_ptr<grpc::Server> server;        // MatchingEngine (clients)
+    std::unique_ptr<grpc::Server> repl_server;   // Replication (primary -> standby, Promote)
+    int port = 0;
+    int repl_port = 0;
+    std::unique_ptr<mat_eng::MatchingEngine::Stub> stub;
+    std::unique_ptr<mat_eng::Replication::Stub> repl_stub;
+  };
+
+  Node standby, primary;
+
+  static void start(Node& n, const std::string& db_name, ReplicationConfig repl) {
+    n.db_path = temp_db_path(db_name);
+    std::remove(n.db_path.c_str());
+    n.service = std::make_unique<MatchingEngineServiceImpl>(n.db_path, RuntimeConfig{}, std::move(repl));
+    n.replication = std::make_unique<ReplicationServiceImpl>(*n.service);
+
+    grpc::ServerBuilder builder;
+    builder.RegisterService(n.service.get());
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &n.port);
+    n.server = builder.BuildAndStart();
+    ASSERT_TRUE(n.server);
+
+    grpc::ServerBuilder repl_builder;
+    repl_builder.RegisterService(n.replication.get());
+    repl_builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &n.repl_port);
+    n.repl_server = repl_builder.BuildAndStart();
+    ASSERT_TRUE(n.repl_server);
+
+    n.stub = mat_eng::MatchingEngine::NewStub(
+        grpc::CreateChannel("127.0.0.1:" + std::to_string(n.port), grpc::InsecureChannelCredentials()));
+    n.repl_stub = mat_eng::Replication::NewStub(
+        grpc::CreateChannel("127.0.0.1:" + std::to_string(n.repl_port), grpc::InsecureChannelCredentials()));
+  }
+
+  static void stop(Node& n) {
+    if (n.server) n.server->Shutdown();
+    if (n.repl_server) n.repl_server->Shutdown();
+    n.service.reset();
+    std::remove(n.db_path.c_str());
+  }
+
+  void SetUp() override {
+    ReplicationConfig s;
+    s.role = ReplicationRole::Standby;
+    start(standby, "repl_test_standby.sqlite", s);
+
+    ReplicationConfig p;
+    p.standby_addr = "127.0.0.1:" + std::to_string(standby.repl_port);
+    p.sync_ack     = true;
+    p.ack_timeout  = 2000ms;
+    start(primary, "repl_test_primary.sqlite", p);
+  }
+
+  void TearDown() override {
+    stop(primary);   // primary first: its replicator talks to the standby
+    stop(standby);
+  }
+
+  static grpc::Status submit(Node& n, mat_eng::OrderResponse* resp, mat_eng::Side side, int64_t price) {
+    mat_eng::OrderRequest req;
+    req.set_client_id("C1");
+    req.set_symbol("SYM");
+    req.set_order_type(mat_eng::LIMIT);
+    req.set_side(side);
+    req.set_price(price);
+    req.set_scale(2);
+    req.set_quantity(10);
+    grpc::ClientContext ctx;
+    return n.stub->SubmitOrder(&ctx, req, resp);
+  }
+
+  static mat_eng::OrderBookResponse book(Node& n) {
+    mat_eng::OrderBookRequest req;
+    req.set_symbol("SYM");
+    grpc::ClientContext ctx;
+    mat_eng::OrderBookResponse resp;
+    EXPECT_TRUE(n.stub->GetOrderBook(&ctx, req, &resp).ok());
+    return resp;
+  }
+};
+
+TEST_F(ReplicationFixture, SyncAckMeansStandbyHasTheOrder) {
+  mat_eng::OrderResponse r1, r2;
+  ASSERT_TRUE(submit(primary, &r1, mat_eng::BUY, 10050).ok());
+  ASSERT_TRUE(submit(primary, &r2, mat_eng::SELL, 10100).ok());
+  ASSERT_TRUE(r1.success()) << r1.error_message();
+  ASSERT_TRUE(r2.success()) << r2.error_message();
+
+  // Acked => already applied on the standby, no polling needed
+  auto b = book(standby);
+  ASSERT_EQ(b.bids_size(), 1);
+  ASSERT_EQ(b.asks_size(), 1);
+  EXPECT_EQ(b.bids(0).order_id(), r1.order_id());
+  EXPECT_EQ(b.bids(0).price(), 1005000);   // Q4
+  EXPECT_EQ(b.asks(0).order_id(), r2.order_id());
+}
+
+TEST_F(ReplicationFixture, CancelReachesStandby) {
+  mat_eng::OrderResponse r;
+  ASSERT_TRUE(submit(primary, &r, mat_eng::BUY, 10050).ok());
+  ASSERT_TRUE(r.success()) << r.error_message();
+
+  mat_eng::CancelRequest req;
+  req.set_client_id("C1");
+  req.set_order_id(r.order_id());
+  mat_eng::CancelResponse resp;
+  grpc::ClientContext ctx;
+  ASSERT_TRUE(primary.stub->CancelOrder(&ctx, req, &resp).ok());
+  ASSERT_TRUE(resp.success()) << resp.error_message();
+
+  EXPECT_EQ(book(primary).bids_size(), 0);
+  EXPECT_EQ(book(standby).bids_size(), 0);
+}
+
+TEST_F(ReplicationFixture, StandbyRejectsOrdersUntilPromoted) {
+  mat_eng::OrderResponse r;
+  ASSERT_TRUE(submit(primary, &r, mat_eng::BUY, 10050).ok());
+  ASSERT_TRUE(r.success());
+
+  mat_eng::OrderResponse refused;
+  EXPECT_EQ(submit(standby, &refused, mat_eng::BUY, 10050).error_code(), grpc::StatusCode::UNAVAILABLE);
+
+  grpc::ClientContext ctx;
+  mat_eng::PromoteResponse pr;
+  ASSERT_TRUE(standby.repl_stub->Promote(&ctx, mat_eng::PromoteRequest{}, &pr).ok());
+  EXPECT_TRUE(pr.success());
+  EXPECT_EQ(pr.applied_seq(), 1u);
+
+  // New primary continues the id sequence instead of reusing OID-1
+  mat_eng::OrderResponse after;
+  ASSERT_TRUE(submit(standby, &after, mat_eng::BUY, 10060).ok());
+  ASSERT_TRUE(after.success()) << after.error_message();
+  EXPECT_EQ(after.order_id(), "OID-2");
+  EXPECT_EQ(book(standby).bids_size(), 2);
+}
+
+TEST_F(ReplicationFixture, ClientEndpointDoesNotServeReplication) {
+  auto on_client_port = mat_eng::Replication::NewStub(
+      grpc::CreateChannel("127.0.0.1:" + std::to_string(standby.port), grpc::InsecureChannelCredentials()));
+  grpc::ClientContext ctx;
+  mat_eng::PromoteResponse pr;
+  EXPECT_EQ(on_client_port->Promote(&ctx, mat_eng::PromoteRequest{}, &pr).error_code(),
+            grpc::StatusCode::UNIMPLEMENTED);
+
+  mat_eng::OrderResponse refused;   // still a standby
+  EXPECT_EQ(submit(standby, &refused, mat_eng::BUY, 10050).error_code(), grpc::StatusCode::UNAVAILABLE);
+}
+
+TEST_F(ReplicationFixture, PromotedNodeFencesOldPrimary) {
+  grpc::ClientContext pctx;
+  mat_eng::PromoteResponse pr;
+  ASSERT_TRUE(standby.repl_stub->Promote(&pctx, mat_eng::PromoteRequest{}, &pr).ok());
+
+  mat_eng::ReplicationBatch batch;
+  batch.set_epoch(42);
+  auto* ev = batch.add_events();
+  ev->set_seq(1);
+  ev->set_order_id("OID-99");
+  ev->set_symbol("SYM");
+  ev->set_side(mat_eng::BUY);
+  ev->set_price_q4(1);
+  ev->set_quantity(1);
+
+  grpc::ClientContext ctx;
+  mat_eng::ReplicationAck ack;
+  EXPECT_EQ(standby.repl_stub->Apply(&ctx, batch, &ack).error_code(), grpc::StatusCode::FAILED_PRECONDITION);
+}
+
+TEST_F(ReplicationFixture, StandbyThatMissedEventsAsksForResync) {
+  // What a primary still holding seq 5.. sends to a standby that restarted (or never saw 1..4)
+  mat_eng::ReplicationBatch batch;
+  batch.set_epoch(42);
+  auto* ev = batch.add_events();
+  ev->set_seq(5);
+  ev->set_order_id("OID-99");
+  ev->set_symbol("SYM");
+  ev->set_side(mat_eng::BUY);
+  ev->set_price_q4(1);
+  ev->set_quantity(1);
+
+  for (int attempt = 0; attempt < 2; ++attempt) {   // stays stuck: resending doesn't fill the gap
+    grpc::ClientContext ctx;
+    mat_eng::ReplicationAck ack;
+    ASSERT_TRUE(standby.repl_stub->Apply(&ctx, batch, &ack).ok());
+    EXPECT_EQ(ack.applied_seq(), 0u);
+    EXPECT_TRUE(ack.needs_resync());
+  }
+  EXPECT_EQ(book(standby).bids_size(), 0);
+}
+
+TEST(ReplicationTimeout, UnconfirmedOrderIsWithdrawnAndCancelIsNotConfirmed) {
+  const std::string db_path = temp_db_path("repl_test_orphan.sqlite");
+  std::remove(db_path.c_str());
+
+  mat_eng::OrderRequest req;
+  req.set_client_id("C1");
+  req.set_symbol("SYM");
+  req.set_order_type(mat_eng::LIMIT);
+  req.set_side(mat_eng::BUY);
+  req.set_price(10050);
+  req.set_scale(2);
+  req.set_quantity(10);
+
+  mat_eng::OrderBookRequest breq;
+  breq.set_symbol("SYM");
+
+  {
+    // Without a standby: OID-1 rests and survives the restart below
+    MatchingEngineServiceImpl service(db_path);
+    mat_eng::OrderResponse resp;
+    ASSERT_TRUE(service.SubmitOrder(nullptr, &req, &resp).ok());
+    ASSERT_EQ(resp.order_id(), "OID-1");
+  }
+  {
+    ReplicationConfig p;
+    p.standby_addr = "127.0.0.1:1";   // nothing listens there
+    p.sync_ack     = true;
+    p.ack_timeout  = 50ms;
+    MatchingEngineServiceImpl service(db_path, RuntimeConfig{}, p);
+
+    mat_eng::OrderResponse resp;
+    const grpc::Status st = service.SubmitOrder(nullptr, &req, &resp);
+    EXPECT_EQ(st.error_code(), grpc::StatusCode::UNAVAILABLE);
+    EXPECT_FALSE(resp.success());
+
+    // The unconfirmed OID-2 was taken back off the book; only the restored OID-1 rests
+    mat_eng::OrderBookResponse book;
+    ASSERT_TRUE(service.GetOrderBook(nullptr, &breq, &book).ok());
+    ASSERT_EQ(book.bids_size(), 1);
+    EXPECT_EQ(book.bids(0).order_id(), "OID-1");
+
+    mat_eng::CancelRequest creq;
+    creq.set_client_id("C1");
+    creq.set_order_id("OID-2");
+    mat_eng::CancelResponse cresp;
+    ASSERT_TRUE(service.CancelOrder(nullptr, &creq, &cresp).ok());
+    EXPECT_FALSE(cresp.success());        // withdrawn, not cancellable
+
+    // A cancel can't be withdrawn: done here, but not reported as a success
+    creq.set_order_id("OID-1");
+    EXPECT_EQ(service.CancelOrder(nullptr, &creq, &cresp).error_code(), grpc::StatusCode::UNAVAILABLE);
+    ASSERT_TRUE(service.GetOrderBook(nullptr, &breq, &book).ok());
+    EXPECT_EQ(book.bids_size(), 0);
+  }
+  std::remove(db_path.c_str());
+}
+
+TEST(ReplicationBacklog, OverflowDropsTheBacklogAndFailsSyncAcksAtOnce) {
+  Replicator repl("127.0.0.1:1", WaitStrategy::Blocking, {});   // standby never answers
+
+  mat_eng::ReplicationEvent ev;
+  ev.set_type(mat_eng::ReplicationEvent::CANCEL);
+  ev.set_order_id("OID-1");
+  uint64_t seq = 0;
+  for (std::size_t i = 0; i <= Replicator::kMaxBacklog; ++i) seq = repl.publish(ev);
+  EXPECT_EQ(seq, Replicator::kMaxBacklog + 1);
+
+  const auto t0 = std::chrono::steady_clock::now();
+  EXPECT_FALSE(repl.wait_acked(seq, 10s));
+  EXPECT_FALSE(repl.wait_acked(1, 10s));
+  EXPECT_LT(std::chrono::steady_clock::now() - t0, 1s);
+}
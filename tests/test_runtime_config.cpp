@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "runtime/runtime_config.hpp"
+#include "runtime/huge_page_arena.hpp"
+#include "runtime/wait_strategy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+TEST(RuntimeConfig, DefaultsAreNoOp) {
+  RuntimeConfig rt;
+  EXPECT_TRUE(rt.io_cpus.empty());
+  EXPECT_TRUE(rt.engine_cpus.empty());
+  EXPECT_EQ(rt.wait_for("anything"), WaitStrategy::Blocking);
+  EXPECT_FALSE(rt.huge_pages);
+  EXPECT_EQ(rt.pool_bytes, 0u);
+}
+
+TEST(RuntimeConfig, SetKeys) {
+  RuntimeConfig rt;
+  rt.set("cpu.io", "2, 3");
+  rt.set("cpu.engine", "4");
+  rt.set("wait.default", "spin_yield");
+  rt.set("wait.replication", "busy_spin");
+  rt.set("memory.pool_mb", "8");
+  rt.set("memory.huge_pages", "true");
+
+  EXPECT_EQ(rt.io_cpus, (std::vector<int>{2, 3}));
+  EXPECT_EQ(rt.engine_cpus, (std::vector<int>{4}));
+  EXPECT_EQ(rt.wait_for("replication"), WaitStrategy::BusySpin);
+  EXPECT_EQ(rt.wait_for("other"), WaitStrategy::SpinYield);
+  EXPECT_EQ(rt.pool_bytes, std::size_t(8) << 20);
+  EXPECT_TRUE(rt.huge_pages);
+
+  EXPECT_THROW(rt.set("cpu.nope", "1"), std::invalid_argument);
+  EXPECT_THROW(rt.set("wait.default", "sleepy"), std::invalid_argument);
+  EXPECT_THROW(rt.set("memory.prefault", "maybe"), std::invalid_argument);
+}
+
+TEST(RuntimeConfig, AdmissionKeys) {
+  RuntimeConfig rt;
+  EXPECT_EQ(rt.admission_max_inflight, 0u);   // unbounded by default
+  EXPECT_EQ(rt.admission_client_rate, 0.0);
+
+  rt.set("admission.shards", "4");
+  rt.set("admission.max_inflight", "64");
+  rt.set("admission.client_rate", "500");
+  rt.set("admission.client_burst", "50");
+  EXPECT_EQ(rt.admission_shards, 4u);
+  EXPECT_EQ(rt.admission_max_inflight, 64u);
+  EXPECT_EQ(rt.admission_client_rate, 500.0);
+  EXPECT_EQ(rt.admission_client_burst, 50.0);
+
+  EXPECT_THROW(rt.set("admission.shards", "0"), std::invalid_argument);
+  EXPECT_THROW(rt.set("admission.client_rate", "-1"), std::invalid_argument);
+}
+
+TEST(RuntimeConfig, LoadFile) {
+  const std::string path = "runtime_config_test.conf";
+  {
+    std::ofstream out(path);
+    out << "# low latency profile\n"
+        << "cpu.persistence = 5\n"
+        << "\n"
+        << "wait.default = busy_spin   # isolated cores\n";
+  }
+  RuntimeConfig rt;
+  rt.load_file(path);
+  std::remove(path.c_str());
+
+  EXPECT_EQ(rt.persistence_cpus, (std::vector<int>{5}));
+  EXPECT_EQ(rt.default_wait, WaitStrategy::BusySpin);
+  EXPECT_THROW(rt.load_file("does_not_exist.conf"), std::runtime_error);
+}
+
+TEST(WaitWith, SpinningWaitersLeaveTheLockToProducers) {
+  using namespace std::chrono_literals;
+  for (WaitStrategy ws : {WaitStrategy::SpinYield, WaitStrategy::BusySpin}) {
+    std::mutex mu;
+    std::condition_variable cv;
+    std::atomic<bool> ready{false};
+    std::atomic<bool> woke{false};
+
+    std::thread waiter([&] {
+      std::unique_lock<std::mutex> lk(mu);
+      woke = wait_with(ws, lk, cv,
+                       [&] { return ready.load(std::memory_order_acquire); },
+                       [&] { return ready.load(std::memory_order_relaxed); });
+    });
+    std::this_thread::sleep_for(10ms);
+
+    // The waiter only polls the atomic, so the mutex is always free for the producer
+    for (int i = 0; i < 10000; ++i) {
+      ASSERT_TRUE(mu.try_lock()) << to_string(ws) << " iteration " << i;
+      mu.unlock();
+    }
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      ready.store(true, std::memory_order_release);
+    }
+    cv.notify_all();
+    waiter.join();
+    EXPECT_TRUE(woke.load());
+
+    std::unique_lock<std::mutex> lk(mu);
+    auto never = [] { return false; };
+    EXPECT_FALSE(wait_with(ws, lk, cv, never, never, std::chrono::steady_clock::now() + 5ms));
+    EXPECT_TRUE(lk.owns_lock());
+  }
+}
+
+TEST(HugePageArena, FallsBackAndAllocates) {
+  // Huge pages are usually not reserved on CI machines: must still work on normal pages
+  HugePageArena arena(std::size_t(1) << 20, /*huge_pages=*/true, /*prefault=*/true);
+  EXPECT_GE(arena.size(), std::size_t(1) << 20);
+
+  void* p = arena.resource()->allocate(256, 64);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 64, 0u);
+  arena.resource()->deallocate(p, 256, 64);
+}
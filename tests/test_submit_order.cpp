@@ -78,3 +78,209 @@ TEST_F(ServerFixture, SubmitOrder_NormalizesAndPersists) {
   auto price_q4 = stmt.getColumn(0).getInt64();
   EXPECT_EQ(price_q4, 1);  // 10050 with scale 8 -> Q4 == 1
 }
+
+TEST_F(ServerFixture, SubmitOrder_RejectsUnspecifiedSide) {
+  mat_eng::OrderRequest req;
+  req.set_client_id("C1");
+  req.set_symbol("SYM");
+  req.set_order_type(mat_eng::LIMIT);
+  req.set_side(mat_eng::SIDE_UNSPECIFIED);
+  req.set_price(250);
+  req.set_scale(2);
+  req.set_quantity(3);
+
+  grpc::ClientContext ctx;
+  mat_eng::OrderResponse resp;
+  ASSERT_TRUE(stub->SubmitOrder(&ctx, req, &resp).ok());
+  EXPECT_FALSE(resp.success());
+  EXPECT_TRUE(resp.order_id().empty());   // validation reject, no id burned
+  EXPECT_EQ(resp.error_message(), "side must be BUY or SELL");
+
+  SQLite::Database db(db_path, SQLite::OPEN_READONLY);
+  SQLite::Statement q(db, "SELECT COUNT(*) FROM orders");
+  ASSERT_TRUE(q.executeStep());
+  EXPECT_EQ(q.getColumn(0).getInt(), 0);
+}
+
+TEST_F(ServerFixture, CancelOrder_RemovesRestingOrderOnce) {
+  mat_eng::OrderRequest req;
+  req.set_client_id("C1");
+  req.set_symbol("SYM");
+  req.set_order_type(mat_eng::LIMIT);
+  req.set_side(mat_eng::SELL);
+  req.set_price(250);
+  req.set_scale(2);
+  req.set_quantity(3);
+  mat_eng::OrderResponse placed;
+  {
+    grpc::ClientContext ctx;
+    ASSERT_TRUE(stub->SubmitOrder(&ctx, req, &placed).ok());
+    ASSERT_TRUE(placed.success());
+  }
+
+  auto cancel = [&](const std::string& client_id) {
+    mat_eng::CancelRequest creq;
+    creq.set_client_id(client_id);
+    creq.set_order_id(placed.order_id());
+    grpc::ClientContext ctx;
+    mat_eng::CancelResponse cresp;
+    EXPECT_TRUE(stub->CancelOrder(&ctx, creq, &cresp).ok());
+    return cresp;
+  };
+
+  EXPECT_EQ(cancel("C2").error_message(), "order belongs to another client");
+  EXPECT_TRUE(cancel("C1").success());
+  EXPECT_EQ(cancel("C1").error_message(), "unknown order");   // already gone
+
+  mat_eng::OrderBookRequest breq;
+  breq.set_symbol("SYM");
+  grpc::ClientContext ctx;
+  mat_eng::OrderBookResponse book;
+  ASSERT_TRUE(stub->GetOrderBook(&ctx, breq, &book).ok());
+  EXPECT_EQ(book.asks_size(), 0);
+
+  SQLite::Database db(db_path, SQLite::OPEN_READONLY);
+  SQLite::Statement stmt(db, "SELECT status, remaining_quantity FROM orders WHERE order_id=?");
+  stmt.bind(1, placed.order_id());
+  ASSERT_TRUE(stmt.executeStep());
+  EXPECT_EQ(stmt.getColumn(0).getInt(), 3);   // CANCELED
+  EXPECT_EQ(stmt.getColumn(1).getInt(), 0);
+}
+
+TEST(AdmissionControlService, ShedsWithResourceExhaustedAndRetryHint) {
+  const std::string db_path = "/tmp/admission_test.sqlite";
+  std::remove(db_path.c_str());
+  {
+    RuntimeConfig rt;
+    rt.set("admission.client_rate", "1");
+    rt.set("admission.client_burst", "1");
+    MatchingEngineServiceImpl service(db_path, rt);
+
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.RegisterService(&service);
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    auto server = builder.BuildAndStart();
+    ASSERT_TRUE(server);
+    auto stub = mat_eng::MatchingEngine::NewStub(
+        grpc::CreateChannel("127.0.0.1:" + std::to_string(port), grpc::InsecureChannelCredentials()));
+
+    auto submit = [&](const std::string& client_id, grpc::ClientContext& ctx) {
+      mat_eng::OrderRequest req;
+      req.set_client_id(client_id);
+      req.set_symbol("SYM");
+      req.set_order_type(mat_eng::LIMIT);
+      req.set_side(mat_eng::BUY);
+      req.set_price(100);
+      req.set_scale(2);
+      req.set_quantity(1);
+      mat_eng::OrderResponse resp;
+      return stub->SubmitOrder(&ctx, req, &resp);
+    };
+
+    grpc::ClientContext first, second, other;
+    EXPECT_TRUE(submit("C1", first).ok());
+    const grpc::Status shed = submit("C1", second);
+    EXPECT_EQ(shed.error_code(), grpc::StatusCode::RESOURCE_EXHAUSTED);
+    const auto& trailers = second.GetServerTrailingMetadata();
+    auto hint = trailers.find(kRetryAfterMetadataKey);
+    ASSERT_NE(hint, trailers.end());
+    EXPECT_GT(std::stoi(std::string(hint->second.data(), hint->second.size())), 0);
+
+    EXPECT_TRUE(submit("C2", other).ok());   // per client_id
+    EXPECT_EQ(service.admission_stats().shed_rate_limited, 1u);
+    server->Shutdown();
+  }
+  std::remove(db_path.c_str());
+}
+
+TEST(AdmissionControlService, InvalidOrdersAreRejectedBeforeAdmission) {
+  const std::string db_path = "/tmp/admission_invalid_test.sqlite";
+  std::remove(db_path.c_str());
+  {
+    RuntimeConfig rt;
+    rt.set("admission.client_rate", "1");
+    rt.set("admission.client_burst", "1");
+    MatchingEngineServiceImpl service(db_path, rt);
+
+    mat_eng::OrderRequest req;
+    req.set_client_id("C1");
+    req.set_symbol("SYM");
+    req.set_order_type(mat_eng::LIMIT);
+    req.set_side(mat_eng::BUY);
+    req.set_price(100);
+    req.set_scale(2);
+    req.set_quantity(0);   // invalid
+    for (int i = 0; i < 3; ++i) {
+      mat_eng::OrderResponse resp;
+      ASSERT_TRUE(service.SubmitOrder(nullptr, &req, &resp).ok());   // a reject, not a shed
+      EXPECT_EQ(resp.error_message(), "quantity must be > 0");
+    }
+    AdmissionStats stats = service.admission_stats();
+    EXPECT_EQ(stats.admitted, 0u);
+    EXPECT_EQ(stats.shed_rate_limited, 0u);
+
+    // The client's single token is still there for a real order
+    req.set_quantity(1);
+    mat_eng::OrderResponse resp;
+    ASSERT_TRUE(service.SubmitOrder(nullptr, &req, &resp).ok());
+    EXPECT_TRUE(resp.success()) << resp.error_message();
+    EXPECT_EQ(service.admission_stats().admitted, 1u);
+  }
+  std::remove(db_path.c_str());
+}
+
+TEST(ServiceRestart, OpenLimitOrdersAreRestoredFromDb) {
+  const std::string db_path = "/tmp/restart_test.sqlite";
+  std::remove(db_path.c_str());
+
+  auto submit = [](MatchingEngineServiceImpl& s, mat_eng::OrderType type, mat_eng::Side side, int64_t price) {
+    mat_eng::OrderRequest req;
+    req.set_client_id("C1");
+    req.set_symbol("SYM");
+    req.set_order_type(type);
+    req.set_side(side);
+    req.set_price(price);
+    req.set_scale(2);
+    req.set_quantity(5);
+    mat_eng::OrderResponse resp;
+    EXPECT_TRUE(s.SubmitOrder(nullptr, &req, &resp).ok());
+    EXPECT_TRUE(resp.success()) << resp.error_message();
+    return resp.order_id();
+  };
+  auto cancel = [](MatchingEngineServiceImpl& s, const std::string& order_id) {
+    mat_eng::CancelRequest req;
+    req.set_client_id("C1");
+    req.set_order_id(order_id);
+    mat_eng::CancelResponse resp;
+    EXPECT_TRUE(s.CancelOrder(nullptr, &req, &resp).ok());
+    return resp;
+  };
+
+  {
+    MatchingEngineServiceImpl before(db_path);
+    submit(before, mat_eng::LIMIT,  mat_eng::BUY,  100);   // OID-1
+    submit(before, mat_eng::LIMIT,  mat_eng::BUY,  100);   // OID-2, behind OID-1
+    submit(before, mat_eng::MARKET, mat_eng::BUY,  100);   // OID-3, never rests
+    const std::string ask = submit(before, mat_eng::LIMIT, mat_eng::SELL, 200);
+    ASSERT_TRUE(cancel(before, ask).success());
+  }
+
+  {
+    MatchingEngineServiceImpl after(db_path);
+    mat_eng::OrderBookRequest breq;
+    breq.set_symbol("SYM");
+    mat_eng::OrderBookResponse book;
+    ASSERT_TRUE(after.GetOrderBook(nullptr, &breq, &book).ok());
+    ASSERT_EQ(book.bids_size(), 2);
+    EXPECT_EQ(book.bids(0).order_id(), "OID-1");   // time priority survives
+    EXPECT_EQ(book.bids(1).order_id(), "OID-2");
+    EXPECT_EQ(book.bids(0).price(), 10000);        // Q4
+    EXPECT_EQ(book.asks_size(), 0);                 // canceled before the restart
+
+    EXPECT_TRUE(cancel(after, "OID-2").success());
+    EXPECT_EQ(cancel(after, "OID-3").error_message(), "unknown order");
+    EXPECT_EQ(submit(after, mat_eng::LIMIT, mat_eng::BUY, 100), "OID-5");
+  }
+  std::remove(db_path.c_str());
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include "gateway/symbol_router.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(SymbolRouter, StableAndInRange) {
+  SymbolRouter a(4), b(4);
+  for (int i = 0; i < 200; ++i) {
+    const std::string sym = "SYM" + std::to_string(i);
+    const auto r = a.route(sym);
+    EXPECT_LT(r, 4u);
+    EXPECT_EQ(r, b.route(sym));   // same placement in every gateway instance
+  }
+}
+
+TEST(SymbolRouter, SpreadsSymbols) {
+  SymbolRouter r(4);
+  std::vector<int> per_backend(4, 0);
+  for (int i = 0; i < 4000; ++i) ++per_backend[r.route("SYM" + std::to_string(i))];
+  for (int n : per_backend) EXPECT_GT(n, 500);   // perfect split is 1000
+}
+
+TEST(SymbolRouter, StaticRouteWins) {
+  SymbolRouter r(3);
+  r.pin("AAPL", 2);
+  EXPECT_EQ(r.route("AAPL"), 2u);
+  EXPECT_THROW(r.pin("MSFT", 3), std::out_of_range);
+}
+
+TEST(SymbolRouter, AddingBackendMovesFewSymbols) {
+  SymbolRouter before(4), after(5);
+  int moved = 0;
+  for (int i = 0; i < 4000; ++i) {
+    const std::string sym = "SYM" + std::to_string(i);
+    if (before.route(sym) != after.route(sym)) ++moved;
+  }
+  EXPECT_LT(moved, 4000 / 3);   // ~1/5 expected; modulo hashing would move ~4/5
+}